@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Turn a CTF trace from overlay-tracing.conf into span latency tables.
+
+The trace directory must hold the channel0_0 stream and the Zephyr CTF
+metadata file. Application spans come from the named events emitted by
+src/modules/app_trace.h (arg1 is 0 at the begin and 1 at the end of a span).
+Scheduling comes from the thread_switched_in and idle events.
+
+Reports:
+  - latency per span: count, min, median, p95, max and mean in microseconds
+  - for each span, the time its thread spent switched out inside the span,
+    broken down by the thread that ran instead
+  - optionally, a Chrome trace event file (--chrome) with one track per
+    thread, which chrome://tracing or ui.perfetto.dev can open as a timeline
+
+Requires the babeltrace2 Python bindings (python3-bt2).
+"""
+
+import argparse
+import bisect
+import json
+import sys
+from collections import defaultdict
+
+try:
+    import bt2
+except ImportError:
+    sys.exit("babeltrace2 Python bindings not found, install python3-bt2")
+
+PHASE_BEGIN = 0
+IDLE = "idle"
+ISR = "isr"
+
+
+class Trace:
+    def __init__(self):
+        # Scheduling segments as (start_ns, end_ns, thread name)
+        self.segments = []
+        # Completed spans as (name, thread, start_ns, end_ns, args), args
+        # holds the arg0 of the begin and of the end marker
+        self.spans = []
+        self.unmatched = 0
+        self.first_ns = None
+        self.last_ns = None
+
+
+def thread_label(thread_id, name):
+    name = str(name).strip("\x00")
+    return name if name else f"0x{thread_id:08x}"
+
+
+def load(path):
+    trace = Trace()
+    running = None
+    running_since = None
+    isr_depth = 0
+    preempted = None
+    open_spans = defaultdict(list)
+
+    def switch(to, ts):
+        nonlocal running, running_since
+        if running is not None and ts > running_since:
+            trace.segments.append((running_since, ts, running))
+        running = to
+        running_since = ts
+
+    for msg in bt2.TraceCollectionMessageIterator(path):
+        if type(msg) is not bt2._EventMessageConst:
+            continue
+
+        ts = msg.default_clock_snapshot.ns_from_origin
+        event = msg.event
+        name = event.name
+        if trace.first_ns is None:
+            trace.first_ns = ts
+        trace.last_ns = ts
+
+        if name == "thread_switched_in":
+            payload = event.payload_field
+            switch(thread_label(int(payload["thread_id"]), payload["name"]),
+                   ts)
+        elif name == "idle":
+            switch(IDLE, ts)
+        elif name == "isr_enter":
+            if isr_depth == 0:
+                preempted = running
+                switch(ISR, ts)
+            isr_depth += 1
+        elif name == "isr_exit":
+            isr_depth = max(isr_depth - 1, 0)
+            if isr_depth == 0 and running == ISR:
+                switch(preempted, ts)
+        elif name == "named_event":
+            payload = event.payload_field
+            span = str(payload["name"]).strip("\x00")
+            arg = int(payload["arg0"])
+            thread = preempted if running == ISR else running
+            key = (span, thread)
+
+            if int(payload["arg1"]) == PHASE_BEGIN:
+                open_spans[key].append((ts, arg))
+            elif open_spans[key]:
+                start, begin_arg = open_spans[key].pop()
+                trace.spans.append((span, thread, start, ts,
+                                    (begin_arg, arg)))
+            else:
+                trace.unmatched += 1
+
+    if running is not None and trace.last_ns is not None:
+        switch(None, trace.last_ns)
+
+    trace.unmatched += sum(len(stack) for stack in open_spans.values())
+    return trace
+
+
+def percentile(values, pct):
+    index = min(len(values) - 1, int(round(pct / 100 * (len(values) - 1))))
+    return values[index]
+
+
+def latency_table(trace):
+    by_name = defaultdict(list)
+    for name, _, start, end, _ in trace.spans:
+        by_name[name].append((end - start) / 1000)
+
+    print(f"{'span':<20} {'count':>7} {'min':>9} {'p50':>9} {'p95':>9} "
+          f"{'max':>9} {'mean':>9}   (us)")
+    for name in sorted(by_name):
+        values = sorted(by_name[name])
+        print(f"{name:<20} {len(values):>7} {values[0]:>9.1f} "
+              f"{percentile(values, 50):>9.1f} {percentile(values, 95):>9.1f} "
+              f"{values[-1]:>9.1f} {sum(values) / len(values):>9.1f}")
+
+
+def delay_table(trace, top):
+    starts = [segment[0] for segment in trace.segments]
+    delays = defaultdict(lambda: defaultdict(int))
+    totals = defaultdict(int)
+
+    for name, thread, start, end, _ in trace.spans:
+        totals[name] += end - start
+        index = max(bisect.bisect_right(starts, start) - 1, 0)
+        while index < len(trace.segments):
+            seg_start, seg_end, seg_thread = trace.segments[index]
+            if seg_start >= end:
+                break
+            overlap = min(seg_end, end) - max(seg_start, start)
+            if overlap > 0 and seg_thread != thread:
+                delays[name][seg_thread] += overlap
+            index += 1
+
+    print()
+    print("Time spent switched out inside each span, by the thread that ran")
+    for name in sorted(delays):
+        ranked = sorted(delays[name].items(), key=lambda item: -item[1])
+        total = totals[name]
+        parts = ", ".join(f"{thread} {ns / 1000:.1f} us "
+                          f"({100 * ns / total:.1f}%)"
+                          for thread, ns in ranked[:top])
+        print(f"  {name:<20} {parts}")
+
+
+def write_chrome(trace, path):
+    origin = trace.first_ns or 0
+    threads = sorted({segment[2] for segment in trace.segments
+                      if segment[2] is not None} |
+                     {span[1] for span in trace.spans if span[1] is not None})
+    tids = {thread: index + 1 for index, thread in enumerate(threads)}
+    events = [{"ph": "M", "name": "thread_name", "pid": 1, "tid": tid,
+               "args": {"name": thread}} for thread, tid in tids.items()]
+
+    for start, end, thread in trace.segments:
+        if thread is None:
+            continue
+        events.append({"ph": "X", "name": "running", "cat": "sched",
+                       "pid": 1, "tid": tids[thread],
+                       "ts": (start - origin) / 1000,
+                       "dur": (end - start) / 1000})
+
+    for name, thread, start, end, (begin_arg, end_arg) in trace.spans:
+        if thread is None:
+            continue
+        events.append({"ph": "X", "name": name, "cat": "app", "pid": 1,
+                       "tid": tids[thread], "ts": (start - origin) / 1000,
+                       "dur": (end - start) / 1000,
+                       "args": {"begin": begin_arg, "end": end_arg}})
+
+    with open(path, "w", encoding="utf-8") as out:
+        json.dump({"traceEvents": events}, out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("trace", help="directory with channel0_0 and metadata")
+    parser.add_argument("--chrome", metavar="FILE",
+                        help="write a Chrome trace event timeline")
+    parser.add_argument("--top", type=int, default=3,
+                        help="threads listed per span in the delay table")
+    args = parser.parse_args()
+
+    trace = load(args.trace)
+    if not trace.spans:
+        sys.exit("No application spans found, was the firmware built with "
+                 "overlay-tracing.conf?")
+
+    duration_ms = (trace.last_ns - trace.first_ns) / 1e6
+    print(f"{len(trace.spans)} spans over {duration_ms:.1f} ms, "
+          f"{trace.unmatched} unmatched markers")
+    print()
+    latency_table(trace)
+    delay_table(trace, args.top)
+
+    if args.chrome:
+        write_chrome(trace, args.chrome)
+        print()
+        print(f"Timeline written to {args.chrome}")
+
+
+if __name__ == "__main__":
+    main()
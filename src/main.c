@@ -9,20 +9,82 @@ LOG_MODULE_REGISTER(main, CONFIG_LOG_DEFAULT_LEVEL);
 
 #include <zephyr/kernel.h>
 #include <zephyr/zbus/zbus.h>
+#include <zephyr/net/net_event.h>
 #include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/sys/atomic.h>
 #include <string.h>
 
+#include "modules/boot/boot_timeline.h"
 #include "modules/button/button.h"
 #include "modules/led/led.h"
 #include "modules/messages.h"
 #include "modules/webserver/webserver.h"
 #include "modules/wifi/wifi.h"
+#include "modules/zbus_stats/zbus_stats.h"
 
 /* ============================================================================
  * APPLICATION STATE MONITORING
  * ============================================================================
  */
 
+/* Conditions that must all hold before the webserver is started */
+enum boot_ready_bit {
+	BOOT_READY_SOFTAP,
+	BOOT_READY_IPV4,
+	BOOT_READY_COUNT,
+};
+
+static ATOMIC_DEFINE(boot_ready, BOOT_READY_COUNT);
+static atomic_t webserver_started;
+static struct net_mgmt_event_callback ipv4_event_cb;
+
+static void webserver_start_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (atomic_set(&webserver_started, 1)) {
+		return;
+	}
+
+	int ret = webserver_start();
+	if (ret < 0) {
+		LOG_ERR("Failed to start webserver: %d", ret);
+		atomic_set(&webserver_started, 0);
+		return;
+	}
+
+	boot_timeline_mark(BOOT_PHASE_HTTP_STARTED);
+	boot_timeline_log();
+}
+
+static K_WORK_DEFINE(webserver_start_work, webserver_start_fn);
+
+static void boot_ready_set(enum boot_ready_bit bit)
+{
+	atomic_set_bit(boot_ready, bit);
+
+	for (int i = 0; i < BOOT_READY_COUNT; i++) {
+		if (!atomic_test_bit(boot_ready, i)) {
+			return;
+		}
+	}
+
+	/* Never start the server from the publisher's or event context */
+	k_work_submit(&webserver_start_work);
+}
+
+static void ipv4_event_handler(struct net_mgmt_event_callback *cb,
+			       uint64_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(iface);
+
+	if (mgmt_event == NET_EVENT_IPV4_ADDR_ADD) {
+		boot_ready_set(BOOT_READY_IPV4);
+	}
+}
+
 /* Subscribe to WiFi events to start webserver when WiFi is ready */
 static void wifi_event_listener(const struct zbus_channel *chan)
 {
@@ -30,18 +92,17 @@ static void wifi_event_listener(const struct zbus_channel *chan)
 
 	if (msg->type == WIFI_SOFTAP_STARTED) {
 		LOG_INF("WiFi SoftAP started, starting webserver...");
-
-		/* Small delay to ensure network is fully configured */
-		k_sleep(K_SECONDS(2));
-
-		int ret = webserver_start();
-		if (ret < 0) {
-			LOG_ERR("Failed to start webserver: %d", ret);
-		}
+		boot_ready_set(BOOT_READY_SOFTAP);
+	} else if (msg->type == WIFI_ERROR) {
+		/* The server is bound to the unspecified address and keeps
+		 * running, it serves again once the SoftAP has recovered
+		 */
+		LOG_WRN("WiFi error %d, webserver left running",
+			msg->error_code);
 	}
 }
 
-ZBUS_LISTENER_DEFINE(wifi_event_listener_def, wifi_event_listener);
+ZBUS_STATS_LISTENER_DEFINE(wifi_event_listener_def, wifi_event_listener);
 
 /* Extern reference to WiFi channel */
 extern const struct zbus_channel WIFI_CHAN;
@@ -58,6 +119,8 @@ int main(void)
 	struct net_linkaddr *mac_addr = net_if_get_link_addr(iface);
 	const char *board_name;
 
+	boot_timeline_mark(BOOT_PHASE_MAIN);
+
 	/* Convert board name to proper case */
 	if (strcmp(CONFIG_BOARD, "nrf7002dk") == 0 ||
 	    strstr(CONFIG_BOARD, "nrf7002dk") != NULL) {
@@ -92,10 +155,20 @@ int main(void)
 	LOG_INF("Then browse to: http://192.168.7.1:%d", CONFIG_APP_HTTP_PORT);
 	LOG_INF("==============================================");
 
-	/* Main thread can sleep forever - everything runs in module threads */
-	while (1) {
-		k_sleep(K_FOREVER);
+	/* The static address is usually assigned before main() runs */
+	net_mgmt_init_event_callback(&ipv4_event_cb, ipv4_event_handler,
+				     NET_EVENT_IPV4_ADDR_ADD);
+	net_mgmt_add_event_callback(&ipv4_event_cb);
+
+	if (iface && net_if_ipv4_get_global_addr(iface, NET_ADDR_ANY_STATE)) {
+		boot_timeline_mark(BOOT_PHASE_IPV4_READY);
+		boot_ready_set(BOOT_READY_IPV4);
 	}
 
+	wifi_module_start();
+
+	/* Modules run on the event loop and the system threads from here on,
+	 * main returns and its thread exits
+	 */
 	return 0;
 }
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file app_trace.h
+ * @brief Named application spans for the Zephyr tracing subsystem
+ *
+ * A span is recorded as two named events that carry the span name, a
+ * span argument (LED or button number, 0 if unused) and the phase. The
+ * host analyzer in scripts/trace_report.py pairs them per thread. Names
+ * are cut to 20 characters by the CTF format.
+ *
+ * Without CONFIG_APP_TRACE_MARKERS the macros expand to nothing.
+ */
+
+#ifndef APP_TRACE_H
+#define APP_TRACE_H
+
+#include <stdint.h>
+
+#if defined(CONFIG_APP_TRACE_MARKERS)
+#include <zephyr/tracing/tracing.h>
+
+#define APP_TRACE_PHASE_BEGIN 0U
+#define APP_TRACE_PHASE_END   1U
+
+#define APP_TRACE_BEGIN(_span, _arg)                                           \
+	sys_trace_named_event(_span, (uint32_t)(_arg), APP_TRACE_PHASE_BEGIN)
+#define APP_TRACE_END(_span, _arg)                                             \
+	sys_trace_named_event(_span, (uint32_t)(_arg), APP_TRACE_PHASE_END)
+#else
+#define APP_TRACE_BEGIN(_span, _arg)                                           \
+	do {                                                                   \
+	} while (0)
+#define APP_TRACE_END(_span, _arg)                                             \
+	do {                                                                   \
+	} while (0)
+#endif /* CONFIG_APP_TRACE_MARKERS */
+
+#endif /* APP_TRACE_H */
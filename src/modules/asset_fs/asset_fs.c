@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "asset_fs.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_asset_fs, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+
+#define MOUNT_POINT "/www"
+#define TMP_SUFFIX  ".tmp"
+#define ASSET_PATH_MAX \
+	(sizeof(MOUNT_POINT) + ASSET_FS_NAME_MAX + sizeof(TMP_SUFFIX))
+
+/* Assets are served with Content-Encoding: gzip, so an upload must be a
+ * gzip member: the magic bytes, a 10 byte header and an 8 byte trailer
+ */
+#define GZIP_ID1         0x1f
+#define GZIP_ID2         0x8b
+#define GZIP_MIN_LEN     18
+#define GZIP_TRAILER_LEN 8
+
+#define CACHE_ENTRIES   CONFIG_APP_ASSET_FS_CACHE_ENTRIES
+#define CACHE_SLOT_SIZE CONFIG_APP_ASSET_FS_CACHE_SLOT_SIZE
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(asset_fs_data);
+
+static struct fs_mount_t asset_fs_mount = {
+	.type = FS_LITTLEFS,
+	.fs_data = &asset_fs_data,
+	.storage_dev = (void *)FIXED_PARTITION_ID(littlefs_storage),
+	.mnt_point = MOUNT_POINT,
+};
+
+static bool mounted;
+
+struct cache_slot {
+	/* Empty when name[0] is 0 */
+	char name[ASSET_FS_NAME_MAX];
+	size_t len;
+	/* Recency sequence number of the last hit */
+	uint32_t used;
+	uint8_t data[CACHE_SLOT_SIZE];
+};
+
+struct asset_fs_stats {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t streamed;
+	uint32_t uploads;
+	uint32_t upload_failures;
+};
+
+static struct cache_slot cache[CACHE_ENTRIES];
+static uint32_t cache_seq;
+static struct asset_fs_stats stats;
+
+/* Read buffer for assets too large for a cache slot */
+static uint8_t chunk_buf[CONFIG_APP_ASSET_FS_CHUNK_SIZE];
+
+struct asset_upload {
+	struct fs_file_t file;
+	char name[ASSET_FS_NAME_MAX];
+	size_t len;
+	bool active;
+};
+
+static struct asset_upload upload;
+
+static int asset_path(char *path, const char *name, const char *suffix)
+{
+	int len = snprintf(path, ASSET_PATH_MAX, MOUNT_POINT "/%s%s", name,
+			   suffix);
+
+	return (len < 0 || len >= ASSET_PATH_MAX) ? -ENAMETOOLONG : 0;
+}
+
+static int name_check(const char *name)
+{
+	size_t len = strlen(name);
+
+	if (!mounted) {
+		return -ENODEV;
+	}
+
+	if (len == 0 || len >= ASSET_FS_NAME_MAX || strchr(name, '/')) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* ============================================================================
+ * RAM CACHE
+ * ============================================================================
+ */
+
+static struct cache_slot *cache_find(const char *name)
+{
+	for (int i = 0; i < CACHE_ENTRIES; i++) {
+		if (strcmp(cache[i].name, name) == 0) {
+			return &cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Empty slot, else the least recently used one */
+static struct cache_slot *cache_victim(void)
+{
+	struct cache_slot *victim = NULL;
+
+	for (int i = 0; i < CACHE_ENTRIES; i++) {
+		if (cache[i].name[0] == '\0') {
+			return &cache[i];
+		}
+		if (!victim || cache[i].used < victim->used) {
+			victim = &cache[i];
+		}
+	}
+
+	return victim;
+}
+
+static void cache_invalidate(const char *name)
+{
+	struct cache_slot *slot = cache_find(name);
+
+	if (slot) {
+		slot->name[0] = '\0';
+	}
+}
+
+/* Read a whole asset into a slot, returns NULL if it could not be cached */
+static struct cache_slot *cache_fill(const char *name, const char *path,
+				     size_t len)
+{
+	struct cache_slot *slot = cache_victim();
+	struct fs_file_t file;
+	ssize_t read;
+	int ret;
+
+	if (!slot || len > CACHE_SLOT_SIZE) {
+		return NULL;
+	}
+
+	slot->name[0] = '\0';
+
+	fs_file_t_init(&file);
+	ret = fs_open(&file, path, FS_O_READ);
+	if (ret < 0) {
+		return NULL;
+	}
+
+	read = fs_read(&file, slot->data, len);
+	fs_close(&file);
+	if (read != (ssize_t)len) {
+		LOG_WRN("Short read of %s: %d", name, (int)read);
+		return NULL;
+	}
+
+	strcpy(slot->name, name);
+	slot->len = len;
+
+	return slot;
+}
+
+/* ============================================================================
+ * READING
+ * ============================================================================
+ */
+
+/* CRC-32 and ISIZE, the last eight bytes of a gzip member */
+static void trailer_parse(struct asset_fs_stream *stream,
+			  const uint8_t *trailer)
+{
+	stream->crc32 = sys_get_le32(trailer);
+	stream->isize = sys_get_le32(trailer + 4);
+}
+
+static int trailer_read(struct asset_fs_stream *stream)
+{
+	uint8_t trailer[GZIP_TRAILER_LEN];
+	ssize_t read;
+	int ret;
+
+	ret = fs_seek(&stream->file, -GZIP_TRAILER_LEN, FS_SEEK_END);
+	if (ret < 0) {
+		return ret;
+	}
+
+	read = fs_read(&stream->file, trailer, sizeof(trailer));
+	if (read != sizeof(trailer)) {
+		return read < 0 ? (int)read : -EIO;
+	}
+
+	trailer_parse(stream, trailer);
+
+	return fs_seek(&stream->file, 0, FS_SEEK_SET);
+}
+
+int asset_fs_open(struct asset_fs_stream *stream, const char *name)
+{
+	char path[ASSET_PATH_MAX];
+	struct fs_dirent entry;
+	struct cache_slot *slot;
+	int ret;
+
+	memset(stream, 0, sizeof(*stream));
+	fs_file_t_init(&stream->file);
+
+	ret = name_check(name);
+	if (ret < 0) {
+		return ret;
+	}
+
+	slot = cache_find(name);
+	if (slot) {
+		stats.hits++;
+		goto cached;
+	}
+
+	ret = asset_path(path, name, "");
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = fs_stat(path, &entry);
+	if (ret < 0) {
+		return ret;
+	}
+
+	stats.misses++;
+
+	slot = cache_fill(name, path, entry.size);
+	if (slot) {
+		goto cached;
+	}
+
+	ret = fs_open(&stream->file, path, FS_O_READ);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (entry.size >= GZIP_MIN_LEN) {
+		ret = trailer_read(stream);
+		if (ret < 0) {
+			fs_close(&stream->file);
+			return ret;
+		}
+	}
+
+	stats.streamed++;
+	stream->file_open = true;
+	stream->remaining = entry.size;
+	return 0;
+
+cached:
+	slot->used = ++cache_seq;
+	stream->cached = slot->data;
+	stream->remaining = slot->len;
+	if (slot->len >= GZIP_MIN_LEN) {
+		trailer_parse(stream, slot->data + slot->len - GZIP_TRAILER_LEN);
+	}
+	return 0;
+}
+
+int asset_fs_read(struct asset_fs_stream *stream, const uint8_t **data,
+		  size_t *len)
+{
+	ssize_t read;
+
+	if (stream->cached) {
+		*data = stream->cached;
+		*len = stream->remaining;
+		stream->remaining = 0;
+		return 1;
+	}
+
+	if (!stream->file_open) {
+		return -EBADF;
+	}
+
+	read = fs_read(&stream->file, chunk_buf,
+		       MIN(stream->remaining, sizeof(chunk_buf)));
+	if (read < 0) {
+		return (int)read;
+	}
+
+	/* The file changed size under us */
+	if (read == 0 && stream->remaining > 0) {
+		return -EIO;
+	}
+
+	stream->remaining -= read;
+	*data = chunk_buf;
+	*len = read;
+
+	return stream->remaining == 0 ? 1 : 0;
+}
+
+void asset_fs_close(struct asset_fs_stream *stream)
+{
+	if (stream->file_open) {
+		fs_close(&stream->file);
+		stream->file_open = false;
+	}
+
+	stream->cached = NULL;
+	stream->remaining = 0;
+}
+
+/* ============================================================================
+ * UPLOAD
+ * ============================================================================
+ */
+
+int asset_fs_write_begin(const char *name)
+{
+	char path[ASSET_PATH_MAX];
+	int ret;
+
+	ret = name_check(name);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (upload.active) {
+		asset_fs_write_end(false);
+	}
+
+	ret = asset_path(path, name, TMP_SUFFIX);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Left behind by an upload cut short by a reset */
+	(void)fs_unlink(path);
+
+	fs_file_t_init(&upload.file);
+	ret = fs_open(&upload.file, path, FS_O_CREATE | FS_O_WRITE);
+	if (ret < 0) {
+		LOG_ERR("Failed to create %s: %d", path, ret);
+		return ret;
+	}
+
+	strcpy(upload.name, name);
+	upload.len = 0;
+	upload.active = true;
+
+	return 0;
+}
+
+int asset_fs_write(const void *data, size_t len)
+{
+	static const uint8_t magic[] = {GZIP_ID1, GZIP_ID2};
+	const uint8_t *bytes = data;
+	ssize_t written;
+
+	if (!upload.active) {
+		return -EBADF;
+	}
+
+	if (upload.len + len > CONFIG_APP_ASSET_FS_MAX_SIZE) {
+		return -EFBIG;
+	}
+
+	/* The magic may be split across the first chunks */
+	for (size_t i = 0; i < len && upload.len + i < sizeof(magic); i++) {
+		if (bytes[i] != magic[upload.len + i]) {
+			return -EINVAL;
+		}
+	}
+
+	written = fs_write(&upload.file, data, len);
+	if (written < 0) {
+		return (int)written;
+	}
+	if (written != (ssize_t)len) {
+		return -ENOSPC;
+	}
+
+	upload.len += len;
+	return 0;
+}
+
+int asset_fs_write_end(bool commit)
+{
+	char tmp_path[ASSET_PATH_MAX];
+	char path[ASSET_PATH_MAX];
+	int ret;
+
+	if (!upload.active) {
+		return -EBADF;
+	}
+
+	upload.active = false;
+
+	(void)asset_path(tmp_path, upload.name, TMP_SUFFIX);
+	(void)asset_path(path, upload.name, "");
+
+	ret = fs_close(&upload.file);
+	if (ret < 0 || !commit) {
+		goto discard;
+	}
+
+	if (upload.len == 0) {
+		ret = -ENODATA;
+		goto discard;
+	}
+
+	if (upload.len < GZIP_MIN_LEN) {
+		ret = -EINVAL;
+		goto discard;
+	}
+
+	/* LittleFS replaces the destination atomically, a reset leaves
+	 * either the old or the new asset
+	 */
+	ret = fs_rename(tmp_path, path);
+	if (ret < 0) {
+		goto discard;
+	}
+
+	cache_invalidate(upload.name);
+	stats.uploads++;
+	LOG_INF("Asset %s replaced, %u bytes", upload.name,
+		(unsigned int)upload.len);
+
+	return upload.len;
+
+discard:
+	(void)fs_unlink(tmp_path);
+	if (commit) {
+		stats.upload_failures++;
+		LOG_ERR("Upload of %s failed: %d", upload.name, ret);
+	}
+
+	return ret;
+}
+
+int asset_fs_remove(const char *name)
+{
+	char path[ASSET_PATH_MAX];
+	int ret;
+
+	ret = name_check(name);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = asset_path(path, name, "");
+	if (ret < 0) {
+		return ret;
+	}
+
+	cache_invalidate(name);
+
+	return fs_unlink(path);
+}
+
+/* ============================================================================
+ * STATUS
+ * ============================================================================
+ */
+
+int asset_fs_json(char *buf, size_t buf_len)
+{
+	struct fs_dir_t dir;
+	struct fs_dirent entry;
+	int offset = 0;
+	int remaining = buf_len;
+	bool first = true;
+	int written;
+
+	written = snprintf(buf, remaining,
+			   "{\"mounted\":%s,\"cache\":{\"slots\":%d,"
+			   "\"slot_size\":%d,\"hits\":%u,\"misses\":%u},"
+			   "\"streamed\":%u,\"uploads\":%u,"
+			   "\"upload_failures\":%u,\"assets\":[",
+			   mounted ? "true" : "false", CACHE_ENTRIES,
+			   CACHE_SLOT_SIZE, stats.hits, stats.misses,
+			   stats.streamed, stats.uploads,
+			   stats.upload_failures);
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	fs_dir_t_init(&dir);
+	if (mounted && fs_opendir(&dir, MOUNT_POINT) == 0) {
+		while (fs_readdir(&dir, &entry) == 0 && entry.name[0] != '\0') {
+			if (entry.type != FS_DIR_ENTRY_FILE) {
+				continue;
+			}
+
+			written = snprintf(
+				buf + offset, remaining,
+				"%s{\"name\":\"%s\",\"size\":%u,\"cached\":%s}",
+				first ? "" : ",", entry.name,
+				(unsigned int)entry.size,
+				cache_find(entry.name) ? "true" : "false");
+			if (written < 0 || written >= remaining) {
+				fs_closedir(&dir);
+				return -ENOMEM;
+			}
+			offset += written;
+			remaining -= written;
+			first = false;
+		}
+
+		fs_closedir(&dir);
+	}
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int asset_fs_init(void)
+{
+	int ret = fs_mount(&asset_fs_mount);
+
+	if (ret < 0) {
+		LOG_ERR("Failed to mount %s: %d, using built-in assets",
+			MOUNT_POINT, ret);
+		return 0;
+	}
+
+	mounted = true;
+	LOG_INF("Web assets mounted at %s", MOUNT_POINT);
+
+	return 0;
+}
+
+SYS_INIT(asset_fs_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file asset_fs.h
+ * @brief Filesystem-backed web assets with a RAM LRU cache
+ *
+ * All functions are meant to be called from the HTTP server thread. A
+ * chunk returned by asset_fs_read() stays valid until the next call into
+ * this module.
+ */
+
+#ifndef ASSET_FS_H
+#define ASSET_FS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/fs/fs.h>
+
+/** Longest accepted asset name, including the terminator */
+#define ASSET_FS_NAME_MAX 16
+
+/** Read state of one asset response */
+struct asset_fs_stream {
+	struct fs_file_t file;
+	/** Asset held in a cache slot, NULL when reading from the file */
+	const uint8_t *cached;
+	size_t remaining;
+	bool file_open;
+	/** CRC-32 and length of the uncompressed content, from the gzip
+	 *  trailer. Together they identify the content, e.g. for an ETag.
+	 */
+	uint32_t crc32;
+	uint32_t isize;
+};
+
+/**
+ * @brief Open a stored asset for reading
+ *
+ * Fills in the content identity from the gzip trailer, so a caller can
+ * answer a conditional request without reading the asset.
+ *
+ * @param stream Stream to initialize
+ * @param name Asset file name, e.g. "main.js"
+ * @return 0 on success, -ENOENT if no asset of that name is stored, or
+ *         another negative error code
+ */
+int asset_fs_open(struct asset_fs_stream *stream, const char *name);
+
+/**
+ * @brief Get the next chunk of an open asset
+ *
+ * @param stream Open stream
+ * @param data Set to the chunk
+ * @param len Set to the chunk length
+ * @return 1 if this was the last chunk, 0 if more follow, or negative
+ *         error code
+ */
+int asset_fs_read(struct asset_fs_stream *stream, const uint8_t **data,
+		  size_t *len);
+
+/**
+ * @brief Release a stream; safe to call on a closed stream
+ */
+void asset_fs_close(struct asset_fs_stream *stream);
+
+/**
+ * @brief Start replacing an asset
+ *
+ * The data is written to a temporary file and only replaces the stored
+ * asset in asset_fs_write_end(). A previous unfinished upload is dropped.
+ *
+ * @param name Asset file name
+ * @return 0 on success, or negative error code
+ */
+int asset_fs_write_begin(const char *name);
+
+/**
+ * @brief Append data to the upload started with asset_fs_write_begin()
+ *
+ * @return 0 on success, -EINVAL if the upload does not start with the gzip
+ *         magic, -EFBIG if CONFIG_APP_ASSET_FS_MAX_SIZE would be exceeded,
+ *         or another negative error code
+ */
+int asset_fs_write(const void *data, size_t len);
+
+/**
+ * @brief Finish an upload
+ *
+ * @param commit true to atomically replace the stored asset, false to
+ *               discard the upload
+ * @return Size of the committed asset, 0 when discarded, -ENODATA if
+ *         nothing was written, -EINVAL if the upload is shorter than a gzip
+ *         header and trailer, or another negative error code
+ */
+int asset_fs_write_end(bool commit);
+
+/**
+ * @brief Remove a stored asset so the built-in copy is served again
+ *
+ * @return 0 on success, -ENOENT if none was stored, or negative error code
+ */
+int asset_fs_remove(const char *name);
+
+/**
+ * @brief Get the stored assets and cache statistics as JSON
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int asset_fs_json(char *buf, size_t buf_len);
+
+#endif /* ASSET_FS_H */
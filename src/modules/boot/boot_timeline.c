@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "boot_timeline.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_boot_timeline, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+static const char *const phase_names[BOOT_PHASE_COUNT] = {
+	[BOOT_PHASE_MAIN] = "main",
+	[BOOT_PHASE_IFACE_UP] = "iface_up",
+	[BOOT_PHASE_SUPPLICANT_READY] = "supplicant_ready",
+	[BOOT_PHASE_ACS_DONE] = "acs_done",
+	[BOOT_PHASE_AP_ENABLE_REQUESTED] = "ap_enable_requested",
+	[BOOT_PHASE_AP_ENABLED] = "ap_enabled",
+	[BOOT_PHASE_IPV4_READY] = "ipv4_ready",
+	[BOOT_PHASE_HTTP_STARTED] = "http_started",
+	[BOOT_PHASE_FIRST_RESPONSE] = "first_response",
+};
+
+/* Microseconds since boot, valid once the phase_reached bit is set */
+static uint32_t phase_us[BOOT_PHASE_COUNT];
+/* The first caller of a phase claims it and stores the time, then
+ * publishes it. The atomic operations are full barriers, so a reader
+ * that sees the reached bit also sees the time.
+ */
+static ATOMIC_DEFINE(phase_claimed, BOOT_PHASE_COUNT);
+static ATOMIC_DEFINE(phase_reached, BOOT_PHASE_COUNT);
+
+void boot_timeline_mark(enum boot_phase phase)
+{
+	if (phase >= BOOT_PHASE_COUNT ||
+	    atomic_test_and_set_bit(phase_claimed, phase)) {
+		return;
+	}
+
+	phase_us[phase] = (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+	atomic_set_bit(phase_reached, phase);
+
+	if (phase == BOOT_PHASE_FIRST_RESPONSE) {
+		boot_timeline_log();
+	}
+}
+
+void boot_timeline_log(void)
+{
+	for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+		if (!atomic_test_bit(phase_reached, i)) {
+			continue;
+		}
+
+		LOG_INF("Boot %-20s %7u.%03u ms", phase_names[i],
+			phase_us[i] / 1000U, phase_us[i] % 1000U);
+	}
+}
+
+int boot_timeline_json(char *buf, size_t buf_len)
+{
+	bool first = true;
+
+	if (!buf || buf_len == 0) {
+		return -EINVAL;
+	}
+
+	int offset = 0;
+	int remaining = buf_len;
+	int written = snprintf(buf, remaining, "{\"phases\":[");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	for (int i = 0; i < BOOT_PHASE_COUNT; i++) {
+		if (!atomic_test_bit(phase_reached, i)) {
+			continue;
+		}
+
+		written = snprintf(buf + offset, remaining,
+				   "%s{\"name\":\"%s\",\"t_us\":%u}",
+				   first ? "" : ",", phase_names[i],
+				   phase_us[i]);
+		if (written < 0 || written >= remaining) {
+			return -ENOMEM;
+		}
+		offset += written;
+		remaining -= written;
+		first = false;
+	}
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	return offset + written;
+}
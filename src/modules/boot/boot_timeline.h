@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file boot_timeline.h
+ * @brief Boot phase timing instrumentation
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <stddef.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Bring-up phases, in expected order
+ */
+enum boot_phase {
+	BOOT_PHASE_MAIN,                /**< main() entered */
+	BOOT_PHASE_IFACE_UP,            /**< WiFi interface up */
+	BOOT_PHASE_SUPPLICANT_READY,    /**< WPA supplicant ready */
+	BOOT_PHASE_ACS_DONE,            /**< Channel selected */
+	BOOT_PHASE_AP_ENABLE_REQUESTED, /**< NET_REQUEST_WIFI_AP_ENABLE issued */
+	BOOT_PHASE_AP_ENABLED,          /**< AP enable result received */
+	BOOT_PHASE_IPV4_READY,          /**< IPv4 address assigned */
+	BOOT_PHASE_HTTP_STARTED,        /**< HTTP server started */
+	BOOT_PHASE_FIRST_RESPONSE,      /**< First completed HTTP response */
+	BOOT_PHASE_COUNT,
+};
+
+#if defined(CONFIG_APP_BOOT_TIMELINE)
+/**
+ * @brief Record the first occurrence of a boot phase
+ *
+ * Later calls for the same phase are ignored, so this is safe to call
+ * from hot paths.
+ *
+ * @param phase Phase reached
+ */
+void boot_timeline_mark(enum boot_phase phase);
+
+/**
+ * @brief Log the recorded timeline
+ */
+void boot_timeline_log(void);
+
+/**
+ * @brief Get the boot timeline as JSON
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int boot_timeline_json(char *buf, size_t buf_len);
+#else
+static inline void boot_timeline_mark(enum boot_phase phase)
+{
+	ARG_UNUSED(phase);
+}
+
+static inline void boot_timeline_log(void)
+{
+}
+#endif /* CONFIG_APP_BOOT_TIMELINE */
+
+#endif /* BOOT_TIMELINE_H */
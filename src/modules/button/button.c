@@ -5,7 +5,13 @@
  */
 
 #include "button.h"
+#include "../app_trace.h"
+#include "../event_loop/event_loop.h"
+#include "../latency/latency_trace.h"
+#include "../log_ratelimit.h"
 #include "../messages.h"
+#include "../state_store/state_store.h"
+#include "../zbus_stats/zbus_stats.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(button_module, CONFIG_BUTTON_MODULE_LOG_LEVEL);
@@ -79,6 +85,8 @@ static void button_pressed_entry(void *obj)
 	struct button_sm_object *sm = (struct button_sm_object *)obj;
 	struct button_msg msg;
 
+	latency_trace_mark(LATENCY_BTN_SMF);
+
 	sm->press_count++;
 
 	msg.type = BUTTON_PRESSED;
@@ -86,12 +94,18 @@ static void button_pressed_entry(void *obj)
 	msg.press_count = sm->press_count;
 	msg.timestamp = k_uptime_get_32();
 
-	int ret = zbus_chan_pub(&BUTTON_CHAN, &msg, K_MSEC(100));
+	latency_trace_mark(LATENCY_BTN_PUBLISH);
+	APP_TRACE_BEGIN("btn_pub", sm->button_number);
+	int ret = zbus_stats_pub(&BUTTON_CHAN, &msg, K_MSEC(100));
+	APP_TRACE_END("btn_pub", sm->button_number);
+	latency_trace_mark(LATENCY_BTN_PUBLISHED);
 	if (ret < 0) {
-		LOG_ERR("Failed to publish button pressed event: %d", ret);
+		APP_LOG_ERR_RL("Failed to publish button pressed event: %d",
+			       ret);
 	} else {
 		const char *label = app_button_label(sm->button_number);
-		LOG_INF("%s pressed (count: %d)", label, sm->press_count);
+		APP_LOG_INF_RL("%s pressed (count: %d)", label,
+			       sm->press_count);
 	}
 }
 
@@ -114,17 +128,24 @@ static void button_released_entry(void *obj)
 	struct button_sm_object *sm = (struct button_sm_object *)obj;
 	struct button_msg msg;
 
+	latency_trace_mark(LATENCY_BTN_SMF);
+
 	msg.type = BUTTON_RELEASED;
 	msg.button_number = sm->button_number;
 	msg.press_count = sm->press_count;
 	msg.timestamp = k_uptime_get_32();
 
-	int ret = zbus_chan_pub(&BUTTON_CHAN, &msg, K_MSEC(100));
+	latency_trace_mark(LATENCY_BTN_PUBLISH);
+	APP_TRACE_BEGIN("btn_pub", sm->button_number);
+	int ret = zbus_stats_pub(&BUTTON_CHAN, &msg, K_MSEC(100));
+	APP_TRACE_END("btn_pub", sm->button_number);
+	latency_trace_mark(LATENCY_BTN_PUBLISHED);
 	if (ret < 0) {
-		LOG_ERR("Failed to publish button released event: %d", ret);
+		APP_LOG_ERR_RL("Failed to publish button released event: %d",
+			       ret);
 	} else {
 		const char *label = app_button_label(sm->button_number);
-		LOG_INF("%s released", label);
+		APP_LOG_INF_RL("%s released", label);
 	}
 
 	/* Return to idle state */
@@ -136,11 +157,8 @@ static void button_released_entry(void *obj)
  * ============================================================================
  */
 
-static void button_handler(uint32_t button_state, uint32_t has_changed)
+static void button_event_process(uint32_t button_state, uint32_t has_changed)
 {
-	LOG_DBG("Button handler: state=0x%08x changed=0x%08x", button_state,
-		has_changed);
-
 	for (int i = 0; i < NUM_BUTTONS; i++) {
 		uint32_t button_mask = BIT(i);
 
@@ -153,7 +171,11 @@ static void button_handler(uint32_t button_state, uint32_t has_changed)
 							   : "released");
 
 			/* Run state machine */
+			latency_trace_begin(LATENCY_PATH_BUTTON);
+			APP_TRACE_BEGIN("btn_smf", i);
 			int ret = smf_run_state(SMF_CTX(&button_sm[i]));
+			APP_TRACE_END("btn_smf", i);
+			latency_trace_end(LATENCY_PATH_BUTTON, i);
 			if (ret < 0) {
 				LOG_ERR("Button SM error: %d", ret);
 			}
@@ -162,26 +184,132 @@ static void button_handler(uint32_t button_state, uint32_t has_changed)
 }
 
 /* ============================================================================
- * BUTTON THREAD
+ * DEBOUNCE
  * ============================================================================
  */
 
-static void button_thread_fn(void *arg1, void *arg2, void *arg3)
+/* A level reported by dk_buttons is passed on once it has held for
+ * CONFIG_BUTTON_DEBOUNCE_MS; every edge restarts the button's window.
+ * One delayable work item on the event loop serves all buttons and is
+ * armed for the earliest pending window.
+ */
+struct button_debounce {
+	bool raw;
+	bool stable;
+	bool pending;
+	uint32_t settle_at;
+	/* Edges seen in the current window */
+	uint32_t edges;
+	uint32_t rejected;
+};
+
+static struct button_debounce debounce[NUM_BUTTONS];
+static struct k_spinlock debounce_lock;
+
+static void debounce_work_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(debounce_work, debounce_work_fn);
+
+static void debounce_work_fn(struct k_work *work)
+{
+	const uint32_t now = k_uptime_get_32();
+	uint32_t button_state = 0;
+	uint32_t has_changed = 0;
+	int32_t next = INT32_MAX;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&debounce_lock);
+	for (int i = 0; i < NUM_BUTTONS; i++) {
+		struct button_debounce *db = &debounce[i];
+		const int32_t left = (int32_t)(db->settle_at - now);
+
+		if (!db->pending) {
+			continue;
+		}
+
+		if (left > 0) {
+			next = MIN(next, left);
+			continue;
+		}
+
+		/* Of the edges in the window, at most one is a real change */
+		db->pending = false;
+		if (db->raw != db->stable) {
+			db->stable = db->raw;
+			db->rejected += db->edges - 1;
+			has_changed |= BIT(i);
+		} else {
+			db->rejected += db->edges;
+		}
+		db->edges = 0;
+
+		if (db->stable) {
+			button_state |= BIT(i);
+		}
+	}
+	k_spin_unlock(&debounce_lock, key);
+
+	if (has_changed) {
+		button_event_process(button_state, has_changed);
+	}
+
+	if (next != INT32_MAX) {
+		event_loop_schedule(&debounce_work, K_MSEC(next));
+	}
+}
+
+/* Called from the dk_buttons scan work on the system work queue. The state
+ * machines and the BUTTON_CHAN publish, which may wait for the channel,
+ * run on the event loop once the level has settled.
+ */
+static void button_handler(uint32_t button_state, uint32_t has_changed)
 {
-	ARG_UNUSED(arg1);
-	ARG_UNUSED(arg2);
-	ARG_UNUSED(arg3);
+	const uint32_t now = k_uptime_get_32();
+	k_spinlock_key_t key;
 
-	LOG_INF("Button module thread started");
+	LOG_DBG("Button handler: state=0x%08x changed=0x%08x", button_state,
+		has_changed);
+
+	key = k_spin_lock(&debounce_lock);
+	for (int i = 0; i < NUM_BUTTONS; i++) {
+		struct button_debounce *db = &debounce[i];
+
+		if (!(has_changed & BIT(i))) {
+			continue;
+		}
 
-	while (1) {
-		/* State machines are run from button_handler callback */
-		k_sleep(K_MSEC(100));
+		db->raw = (button_state & BIT(i)) != 0;
+		db->settle_at = now + CONFIG_BUTTON_DEBOUNCE_MS;
+		db->pending = true;
+		db->edges++;
 	}
+	k_spin_unlock(&debounce_lock, key);
+
+	/* No-op while armed for an earlier window, re-armed from there */
+	event_loop_schedule(&debounce_work, K_MSEC(CONFIG_BUTTON_DEBOUNCE_MS));
 }
 
-K_THREAD_DEFINE(button_thread_id, 1024, button_thread_fn, NULL, NULL, NULL, 7,
-		0, 0);
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+int button_bounce_count_get(uint8_t button_number, uint32_t *count)
+{
+	k_spinlock_key_t key;
+
+	if (button_number >= NUM_BUTTONS || !count) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&debounce_lock);
+	*count = debounce[button_number].rejected;
+	k_spin_unlock(&debounce_lock, key);
+
+	return 0;
+}
 
 /* ============================================================================
  * MODULE INITIALIZATION
@@ -204,10 +332,13 @@ int button_module_init(void)
 
 	LOG_INF("DK buttons initialized successfully");
 
+	state_store_load();
+
 	/* Initialize state machines for each button */
 	for (int i = 0; i < NUM_BUTTONS; i++) {
 		button_sm[i].button_number = i;
 		button_sm[i].press_count = 0;
+		state_store_press_count_get(i, &button_sm[i].press_count);
 		button_sm[i].current_state = false;
 		button_sm[i].previous_state = false;
 
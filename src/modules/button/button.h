@@ -12,6 +12,7 @@
 #ifndef BUTTON_H
 #define BUTTON_H
 
+#include <stdint.h>
 #include <zephyr/kernel.h>
 
 /**
@@ -20,4 +21,12 @@
  */
 int button_module_init(void);
 
+/**
+ * @brief Get the number of edges rejected by the debounce filter
+ * @param button_number Button index
+ * @param count Rejected edges since boot
+ * @return 0 on success, -EINVAL for an invalid button
+ */
+int button_bounce_count_get(uint8_t button_number, uint32_t *count);
+
 #endif /* BUTTON_H */
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "dhcp_cache.h"
+#include "../network/network.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_dhcp_cache, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/net/dhcpv4_server.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <zephyr/settings/settings.h>
+
+#define CACHE_ENTRIES CONFIG_APP_DHCP_LEASE_CACHE_ENTRIES
+
+/* Stations tracked between association and lease */
+#define MAX_PENDING_STATIONS 4
+
+/* Stop polling for a lease after this long */
+#define LEASE_POLL_TIMEOUT_MS 10000
+
+/* Persisted record, stored as one settings value */
+struct lease_entry {
+	uint8_t mac[6];
+	struct in_addr addr;
+	/* Recency sequence number, 0 marks a free entry */
+	uint32_t seen;
+};
+
+struct pending_station {
+	bool valid;
+	uint8_t mac[6];
+	int64_t assoc_time;
+};
+
+struct dhcp_cache_stats {
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t writes;
+	uint32_t last_lease_ms;
+	uint32_t max_lease_ms;
+};
+
+static struct lease_entry cache[CACHE_ENTRIES];
+static uint32_t cache_seq;
+static bool cache_dirty;
+static struct dhcp_cache_stats stats;
+static K_MUTEX_DEFINE(cache_mutex);
+
+/* Lock order: pending_mutex, DHCP server, cache_mutex */
+static struct pending_station pending[MAX_PENDING_STATIONS];
+static K_MUTEX_DEFINE(pending_mutex);
+
+static struct net_mgmt_event_callback sta_event_cb;
+
+/* ============================================================================
+ * CACHE
+ * ============================================================================
+ */
+
+/* Caller holds cache_mutex */
+static struct lease_entry *cache_find(const uint8_t *mac)
+{
+	for (int i = 0; i < CACHE_ENTRIES; i++) {
+		if (cache[i].seen != 0 && memcmp(cache[i].mac, mac, 6) == 0) {
+			return &cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_save_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(cache_save_work, cache_save_fn);
+
+static void cache_save_fn(struct k_work *work)
+{
+	static struct lease_entry copy[CACHE_ENTRIES];
+	int ret;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	memcpy(copy, cache, sizeof(copy));
+	cache_dirty = false;
+	k_mutex_unlock(&cache_mutex);
+
+	ret = settings_save_one("dhcp/leases", copy, sizeof(copy));
+	if (ret) {
+		LOG_WRN("Failed to save lease cache: %d", ret);
+		return;
+	}
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	stats.writes++;
+	k_mutex_unlock(&cache_mutex);
+}
+
+/* Record a lease, evicting the least recently seen entry if needed */
+static void cache_store(const uint8_t *mac, const struct in_addr *addr)
+{
+	struct lease_entry *entry;
+	bool changed = false;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	/* An address belongs to one station, drop stale owners */
+	for (int i = 0; i < CACHE_ENTRIES; i++) {
+		if (cache[i].seen != 0 && cache[i].addr.s_addr == addr->s_addr &&
+		    memcmp(cache[i].mac, mac, 6) != 0) {
+			memset(&cache[i], 0, sizeof(cache[i]));
+			changed = true;
+		}
+	}
+
+	entry = cache_find(mac);
+	if (!entry) {
+		entry = &cache[0];
+		for (int i = 1; i < CACHE_ENTRIES; i++) {
+			if (cache[i].seen < entry->seen) {
+				entry = &cache[i];
+			}
+		}
+		memcpy(entry->mac, mac, 6);
+		entry->addr.s_addr = 0;
+	}
+
+	if (entry->addr.s_addr != addr->s_addr) {
+		entry->addr = *addr;
+		changed = true;
+	}
+
+	/* Recency alone is not worth a flash write */
+	entry->seen = ++cache_seq;
+
+	if (changed) {
+		cache_dirty = true;
+		/* Schedule, not reschedule: bound the delay from first change */
+		k_work_schedule(&cache_save_work,
+				K_MSEC(CONFIG_APP_DHCP_LEASE_CACHE_WRITE_DELAY_MS));
+	}
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+/* ============================================================================
+ * ADDRESS PROVIDER
+ * ============================================================================
+ */
+
+static int lease_provider(struct net_if *iface,
+			  const struct dhcpv4_client_id *client_id,
+			  struct in_addr *addr, void *user_data)
+{
+	const struct lease_entry *entry = NULL;
+
+	ARG_UNUSED(iface);
+	ARG_UNUSED(user_data);
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	/* Client identifier is hardware type 1 (Ethernet) followed by MAC */
+	if (client_id->len == 7 && client_id->buf[0] == 1) {
+		entry = cache_find(&client_id->buf[1]);
+	}
+
+	/* Cached addresses are unique per MAC, see cache_store() */
+	if (entry) {
+		*addr = entry->addr;
+		stats.hits++;
+	} else {
+		stats.misses++;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	/* -ENOENT falls back to the server's own pool allocation */
+	return entry ? 0 : -ENOENT;
+}
+
+/* ============================================================================
+ * LEASE TRACKING
+ * ============================================================================
+ */
+
+static void lease_poll_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(lease_poll_work, lease_poll_fn);
+
+static void lease_poll_fn(struct k_work *work)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	int64_t now = k_uptime_get();
+	bool waiting = false;
+
+	ARG_UNUSED(work);
+
+	if (!iface) {
+		return;
+	}
+
+	k_mutex_lock(&pending_mutex, K_FOREVER);
+
+	for (int i = 0; i < MAX_PENDING_STATIONS; i++) {
+		struct pending_station *sta = &pending[i];
+		struct in_addr addr;
+		uint32_t lease_ms;
+		int ret;
+
+		if (!sta->valid) {
+			continue;
+		}
+
+		ret = network_lease_addr_get(iface, sta->mac, &addr);
+		lease_ms = (uint32_t)(now - sta->assoc_time);
+
+		if (ret < 0) {
+			if (lease_ms >= LEASE_POLL_TIMEOUT_MS) {
+				LOG_WRN("No lease after %u ms", lease_ms);
+				sta->valid = false;
+			} else {
+				waiting = true;
+			}
+			continue;
+		}
+
+		k_mutex_lock(&cache_mutex, K_FOREVER);
+		stats.last_lease_ms = lease_ms;
+		stats.max_lease_ms = MAX(stats.max_lease_ms, lease_ms);
+		k_mutex_unlock(&cache_mutex);
+
+		LOG_INF("Station leased in %u ms", lease_ms);
+		cache_store(sta->mac, &addr);
+		sta->valid = false;
+	}
+
+	k_mutex_unlock(&pending_mutex);
+
+	if (waiting) {
+		k_work_reschedule(&lease_poll_work,
+				  K_MSEC(CONFIG_APP_DHCP_LEASE_CACHE_POLL_MS));
+	}
+}
+
+static void sta_event_handler(struct net_mgmt_event_callback *cb,
+			      uint64_t mgmt_event, struct net_if *iface)
+{
+	const struct wifi_ap_sta_info *sta_info =
+		(const struct wifi_ap_sta_info *)cb->info;
+
+	ARG_UNUSED(iface);
+
+	k_mutex_lock(&pending_mutex, K_FOREVER);
+
+	for (int i = 0; i < MAX_PENDING_STATIONS; i++) {
+		if (pending[i].valid &&
+		    memcmp(pending[i].mac, sta_info->mac, 6) == 0) {
+			pending[i].valid = false;
+		}
+	}
+
+	if (mgmt_event != NET_EVENT_WIFI_AP_STA_CONNECTED) {
+		k_mutex_unlock(&pending_mutex);
+		return;
+	}
+
+	for (int i = 0; i < MAX_PENDING_STATIONS; i++) {
+		if (!pending[i].valid) {
+			memcpy(pending[i].mac, sta_info->mac, 6);
+			pending[i].assoc_time = k_uptime_get();
+			pending[i].valid = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&pending_mutex);
+
+	k_work_reschedule(&lease_poll_work,
+			  K_MSEC(CONFIG_APP_DHCP_LEASE_CACHE_POLL_MS));
+}
+
+/* ============================================================================
+ * SETTINGS
+ * ============================================================================
+ */
+
+static int dhcp_cache_set(const char *key, size_t len,
+			  settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	ssize_t ret;
+
+	if (!settings_name_steq(key, "leases", &next) || next) {
+		return -ENOENT;
+	}
+
+	/* A stored table from a build with another size is still usable */
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	memset(cache, 0, sizeof(cache));
+	ret = read_cb(cb_arg, cache, MIN(len, sizeof(cache)));
+	if (ret >= 0) {
+		for (int i = 0; i < CACHE_ENTRIES; i++) {
+			cache_seq = MAX(cache_seq, cache[i].seen);
+		}
+	}
+	k_mutex_unlock(&cache_mutex);
+
+	return ret < 0 ? (int)ret : 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(dhcp_cache, "dhcp", NULL, dhcp_cache_set, NULL,
+			       NULL);
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+int dhcp_cache_json(char *buf, size_t buf_len)
+{
+	char ip_str[NET_IPV4_ADDR_LEN];
+	bool first = true;
+	int offset = 0;
+	int remaining = buf_len;
+	int written;
+
+	if (!buf || buf_len == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	written = snprintf(buf, remaining,
+			   "{\"hits\":%u,\"misses\":%u,\"writes\":%u,"
+			   "\"pending_write\":%s,\"last_lease_ms\":%u,"
+			   "\"max_lease_ms\":%u,\"leases\":[",
+			   stats.hits, stats.misses, stats.writes,
+			   cache_dirty ? "true" : "false", stats.last_lease_ms,
+			   stats.max_lease_ms);
+	if (written < 0 || written >= remaining) {
+		goto nomem;
+	}
+	offset += written;
+	remaining -= written;
+
+	for (int i = 0; i < CACHE_ENTRIES; i++) {
+		const struct lease_entry *entry = &cache[i];
+
+		if (entry->seen == 0) {
+			continue;
+		}
+
+		net_addr_ntop(AF_INET, &entry->addr, ip_str, sizeof(ip_str));
+		written = snprintf(buf + offset, remaining,
+				   "%s{\"mac\":\"%02x:%02x:%02x:%02x:%02x:%02x\","
+				   "\"ip\":\"%s\"}",
+				   first ? "" : ",", entry->mac[0],
+				   entry->mac[1], entry->mac[2], entry->mac[3],
+				   entry->mac[4], entry->mac[5], ip_str);
+		if (written < 0 || written >= remaining) {
+			goto nomem;
+		}
+		offset += written;
+		remaining -= written;
+		first = false;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+
+nomem:
+	k_mutex_unlock(&cache_mutex);
+	return -ENOMEM;
+}
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int dhcp_cache_init(void)
+{
+	int ret;
+	int count = 0;
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Settings init failed: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree("dhcp");
+	if (ret) {
+		LOG_WRN("Failed to load lease cache: %d", ret);
+	}
+
+	for (int i = 0; i < CACHE_ENTRIES; i++) {
+		count += (cache[i].seen != 0);
+	}
+	LOG_INF("Restored %d cached leases", count);
+
+	/* Registered before the SoftAP state machine starts the server */
+	net_dhcpv4_server_set_provider_cb(lease_provider, NULL);
+
+	net_mgmt_init_event_callback(&sta_event_cb, sta_event_handler,
+				     NET_EVENT_WIFI_AP_STA_CONNECTED |
+					     NET_EVENT_WIFI_AP_STA_DISCONNECTED);
+	net_mgmt_add_event_callback(&sta_event_cb);
+
+	return 0;
+}
+
+SYS_INIT(dhcp_cache_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file dhcp_cache.h
+ * @brief Persistent DHCP lease cache
+ */
+
+#ifndef DHCP_CACHE_H
+#define DHCP_CACHE_H
+
+#include <stddef.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Get the lease cache and reconnect statistics as JSON
+ *
+ * Reports cache hits and misses, flash writes, the association to lease
+ * time of the last and slowest station, and the cached MAC/IP pairs.
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int dhcp_cache_json(char *buf, size_t buf_len);
+
+#endif /* DHCP_CACHE_H */
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "event_loop.h"
+
+#include <zephyr/init.h>
+
+struct k_work_q event_loop_q;
+
+static K_THREAD_STACK_DEFINE(event_loop_stack,
+			     CONFIG_APP_EVENT_LOOP_STACK_SIZE);
+
+static int event_loop_init(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "app_events",
+	};
+
+	k_work_queue_start(&event_loop_q, event_loop_stack,
+			   K_THREAD_STACK_SIZEOF(event_loop_stack),
+			   CONFIG_APP_EVENT_LOOP_PRIORITY, &cfg);
+
+	return 0;
+}
+
+/* Ahead of the APPLICATION level module inits, which submit to it */
+SYS_INIT(event_loop_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file event_loop.h
+ * @brief Shared application event loop
+ *
+ * Modules queue work items here instead of running a thread each. Items
+ * run one at a time in submission order, so state machines driven from
+ * the loop need no locking against each other.
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <zephyr/kernel.h>
+
+/** Work queue behind the loop, started before the application modules */
+extern struct k_work_q event_loop_q;
+
+/**
+ * @brief Queue a work item on the event loop
+ */
+static inline int event_loop_submit(struct k_work *work)
+{
+	return k_work_submit_to_queue(&event_loop_q, work);
+}
+
+/**
+ * @brief Queue a delayable work item on the event loop
+ */
+static inline int event_loop_schedule(struct k_work_delayable *dwork,
+				      k_timeout_t delay)
+{
+	return k_work_schedule_for_queue(&event_loop_q, dwork, delay);
+}
+
+#endif /* EVENT_LOOP_H */
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "latency_trace.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_latency, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/timing/timing.h>
+
+#define RING_SIZE CONFIG_APP_LATENCY_TRACE_RING
+
+/* Log2 buckets: <1 us, [1, 2) us, ... [512, 1024) us, >= 1024 us */
+#define HIST_BUCKETS 12
+
+struct stage_desc {
+	const char *name;
+	enum latency_path path;
+};
+
+/* A stage measures the time since the previous stage reached, or since
+ * the start of the trace
+ */
+static const struct stage_desc stage_descs[LATENCY_STAGE_COUNT] = {
+	[LATENCY_LED_PARSED] = {"parse", LATENCY_PATH_LED},
+	[LATENCY_LED_LISTENER] = {"zbus_dispatch", LATENCY_PATH_LED},
+	[LATENCY_LED_SMF] = {"smf_transition", LATENCY_PATH_LED},
+	[LATENCY_LED_GPIO] = {"gpio", LATENCY_PATH_LED},
+	[LATENCY_LED_PUBLISHED] = {"publish_return", LATENCY_PATH_LED},
+	[LATENCY_BTN_SMF] = {"smf_run", LATENCY_PATH_BUTTON},
+	[LATENCY_BTN_PUBLISH] = {"publish", LATENCY_PATH_BUTTON},
+	[LATENCY_BTN_LISTENER] = {"zbus_dispatch", LATENCY_PATH_BUTTON},
+	[LATENCY_BTN_PUBLISHED] = {"publish_return", LATENCY_PATH_BUTTON},
+};
+
+static const char *const path_names[LATENCY_PATH_COUNT] = {
+	[LATENCY_PATH_LED] = "led_command",
+	[LATENCY_PATH_BUTTON] = "button",
+};
+
+struct latency_stats {
+	uint32_t count;
+	uint32_t max_ns;
+	uint64_t total_ns;
+	uint32_t hist[HIST_BUCKETS];
+};
+
+/* Trace in flight, only touched by its owner thread until it ends */
+struct active_trace {
+	k_tid_t owner;
+	timing_t start;
+	timing_t marks[LATENCY_STAGE_COUNT];
+	uint32_t marked;
+};
+
+struct trace_record {
+	uint32_t uptime_ms;
+	uint32_t total_ns;
+	uint32_t stage_ns[LATENCY_STAGE_COUNT];
+	uint32_t marked;
+	uint8_t path;
+	uint8_t tag;
+};
+
+static struct active_trace active[LATENCY_PATH_COUNT];
+static struct latency_stats path_stats[LATENCY_PATH_COUNT];
+static struct latency_stats stage_stats[LATENCY_STAGE_COUNT];
+static struct trace_record ring[RING_SIZE];
+/* Traces kept in the ring, the newest is at (ring_count - 1) % RING_SIZE */
+static uint32_t ring_count;
+static uint32_t traces_seen;
+static struct k_spinlock lock;
+
+static uint32_t cycles_to_ns(timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end);
+
+	return (uint32_t)MIN(timing_cycles_to_ns(cycles), UINT32_MAX);
+}
+
+static void stats_add(struct latency_stats *stats, uint32_t ns)
+{
+	uint32_t us = ns / 1000U;
+	int bucket = (us == 0) ? 0 : 32 - __builtin_clz(us);
+
+	stats->count++;
+	stats->total_ns += ns;
+	stats->max_ns = MAX(stats->max_ns, ns);
+	stats->hist[MIN(bucket, HIST_BUCKETS - 1)]++;
+}
+
+/* ============================================================================
+ * TRACING
+ * ============================================================================
+ */
+
+void latency_trace_begin(enum latency_path path)
+{
+	struct active_trace *trace = &active[path];
+
+	trace->marked = 0;
+	trace->owner = k_current_get();
+	trace->start = timing_counter_get();
+}
+
+void latency_trace_mark(enum latency_stage stage)
+{
+	struct active_trace *trace = &active[stage_descs[stage].path];
+
+	if (trace->owner != k_current_get()) {
+		return;
+	}
+
+	trace->marks[stage] = timing_counter_get();
+	trace->marked |= BIT(stage);
+}
+
+void latency_trace_end(enum latency_path path, uint8_t tag)
+{
+	struct active_trace *trace = &active[path];
+	const timing_t end = timing_counter_get();
+	struct trace_record rec = {0};
+	timing_t prev = trace->start;
+	k_spinlock_key_t key;
+
+	if (trace->owner != k_current_get()) {
+		return;
+	}
+	trace->owner = NULL;
+
+	rec.path = path;
+	rec.tag = tag;
+	rec.marked = trace->marked;
+	rec.uptime_ms = k_uptime_get_32();
+	rec.total_ns = cycles_to_ns(trace->start, end);
+
+	for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+		if (rec.marked & BIT(i)) {
+			rec.stage_ns[i] = cycles_to_ns(prev, trace->marks[i]);
+			prev = trace->marks[i];
+		}
+	}
+
+	key = k_spin_lock(&lock);
+
+	stats_add(&path_stats[path], rec.total_ns);
+	for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+		if (rec.marked & BIT(i)) {
+			stats_add(&stage_stats[i], rec.stage_ns[i]);
+		}
+	}
+
+	if (traces_seen++ % CONFIG_APP_LATENCY_TRACE_SAMPLE_RATE == 0) {
+		ring[ring_count % RING_SIZE] = rec;
+		ring_count++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+/* ============================================================================
+ * JSON REPORT
+ * ============================================================================
+ */
+
+/* Report items: header, path totals, stages, recent traces, footer */
+#define ITEM_STATS_FIRST  1U
+#define ITEM_STATS_COUNT  (LATENCY_PATH_COUNT + LATENCY_STAGE_COUNT)
+#define ITEM_RECENT_OPEN  (ITEM_STATS_FIRST + ITEM_STATS_COUNT)
+#define ITEM_RECENT_FIRST (ITEM_RECENT_OPEN + 1U)
+#define ITEM_FOOTER       (ITEM_RECENT_FIRST + RING_SIZE)
+
+static int format_stats(char *buf, size_t buf_len, uint32_t index)
+{
+	const char *sep = (index == 0U) ? "" : ",";
+	struct latency_stats stats;
+	const char *path;
+	const char *stage;
+	k_spinlock_key_t key;
+	int offset;
+	int written;
+
+	key = k_spin_lock(&lock);
+	if (index < LATENCY_PATH_COUNT) {
+		stats = path_stats[index];
+		path = path_names[index];
+		stage = "total";
+	} else {
+		index -= LATENCY_PATH_COUNT;
+		stats = stage_stats[index];
+		path = path_names[stage_descs[index].path];
+		stage = stage_descs[index].name;
+	}
+	k_spin_unlock(&lock, key);
+
+	offset = snprintf(buf, buf_len,
+			  "%s{\"path\":\"%s\",\"stage\":\"%s\",\"count\":%u,"
+			  "\"avg_ns\":%u,\"max_ns\":%u,\"hist\":[",
+			  sep, path, stage, stats.count,
+			  stats.count ? (uint32_t)(stats.total_ns / stats.count)
+				      : 0,
+			  stats.max_ns);
+	if (offset < 0 || offset >= (int)buf_len) {
+		return -ENOMEM;
+	}
+
+	for (int i = 0; i < HIST_BUCKETS; i++) {
+		written = snprintf(buf + offset, buf_len - offset, "%s%u",
+				   i == 0 ? "" : ",", stats.hist[i]);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			return -ENOMEM;
+		}
+		offset += written;
+	}
+
+	written = snprintf(buf + offset, buf_len - offset, "]}");
+	if (written < 0 || written >= (int)(buf_len - offset)) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+/* Returns 0 when the slot holds no trace */
+static int format_recent(char *buf, size_t buf_len, uint32_t index)
+{
+	struct trace_record rec;
+	k_spinlock_key_t key;
+	bool first = true;
+	int offset;
+	int written;
+
+	key = k_spin_lock(&lock);
+	if (index >= MIN(ring_count, RING_SIZE)) {
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+	rec = ring[(ring_count - 1U - index) % RING_SIZE];
+	k_spin_unlock(&lock, key);
+
+	offset = snprintf(buf, buf_len,
+			  "%s{\"path\":\"%s\",\"tag\":%u,\"uptime_ms\":%u,"
+			  "\"total_ns\":%u,\"stages_ns\":{",
+			  index == 0 ? "" : ",", path_names[rec.path], rec.tag,
+			  rec.uptime_ms, rec.total_ns);
+	if (offset < 0 || offset >= (int)buf_len) {
+		return -ENOMEM;
+	}
+
+	for (int i = 0; i < LATENCY_STAGE_COUNT; i++) {
+		if (!(rec.marked & BIT(i))) {
+			continue;
+		}
+
+		written = snprintf(buf + offset, buf_len - offset,
+				   "%s\"%s\":%u", first ? "" : ",",
+				   stage_descs[i].name, rec.stage_ns[i]);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			return -ENOMEM;
+		}
+		offset += written;
+		first = false;
+	}
+
+	written = snprintf(buf + offset, buf_len - offset, "}}");
+	if (written < 0 || written >= (int)(buf_len - offset)) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+static int format_item(char *buf, size_t buf_len, uint32_t item)
+{
+	if (item == 0U) {
+		return snprintf(buf, buf_len,
+				"{\"timer_mhz\":%u,\"bucket_us\":[1,2,4,8,16,"
+				"32,64,128,256,512,1024],\"stats\":[",
+				timing_freq_get_mhz());
+	}
+
+	if (item < ITEM_RECENT_OPEN) {
+		return format_stats(buf, buf_len, item - ITEM_STATS_FIRST);
+	}
+
+	if (item == ITEM_RECENT_OPEN) {
+		return snprintf(buf, buf_len, "],\"recent\":[");
+	}
+
+	if (item < ITEM_FOOTER) {
+		return format_recent(buf, buf_len, item - ITEM_RECENT_FIRST);
+	}
+
+	return snprintf(buf, buf_len, "]}");
+}
+
+int latency_trace_json_chunk(char *buf, size_t buf_len, uint32_t *cursor,
+			     bool *done)
+{
+	int offset = 0;
+	int written;
+
+	if (!buf || buf_len == 0 || !cursor || !done) {
+		return -EINVAL;
+	}
+
+	*done = false;
+
+	while (*cursor <= ITEM_FOOTER) {
+		written = format_item(buf + offset, buf_len - offset, *cursor);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			if (offset == 0) {
+				return -ENOMEM;
+			}
+			/* Item goes into the next chunk */
+			buf[offset] = '\0';
+			return offset;
+		}
+
+		offset += written;
+		(*cursor)++;
+	}
+
+	*done = true;
+	return offset;
+}
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int latency_trace_init(void)
+{
+	timing_init();
+	timing_start();
+
+	LOG_INF("Latency tracing at %u MHz", timing_freq_get_mhz());
+
+	return 0;
+}
+
+SYS_INIT(latency_trace_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
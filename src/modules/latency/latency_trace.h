@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file latency_trace.h
+ * @brief Per-stage latency tracing of the LED command and button paths
+ *
+ * A trace is started at the entry of a path, stages are marked as the
+ * event passes through zbus listeners and state machines, and the trace
+ * is closed where the path returns. All stages of a path run on the
+ * thread that started it; marks from other threads are ignored.
+ */
+
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Traced paths
+ */
+enum latency_path {
+	LATENCY_PATH_LED,    /**< POST /api/led to GPIO */
+	LATENCY_PATH_BUTTON, /**< Button interrupt to web state */
+	LATENCY_PATH_COUNT,
+};
+
+/**
+ * @brief Stages, grouped by path in path order
+ */
+enum latency_stage {
+	LATENCY_LED_PARSED,    /**< Request parsed and validated */
+	LATENCY_LED_LISTENER,  /**< led_cmd_listener entered */
+	LATENCY_LED_SMF,       /**< LED state entry reached */
+	LATENCY_LED_GPIO,      /**< dk_set_led_* returned */
+	LATENCY_LED_PUBLISHED, /**< zbus_chan_pub returned to the handler */
+	LATENCY_BTN_SMF,       /**< Pressed/released state entry reached */
+	LATENCY_BTN_PUBLISH,   /**< BUTTON_CHAN publish issued */
+	LATENCY_BTN_LISTENER,  /**< Webserver button listener entered */
+	LATENCY_BTN_PUBLISHED, /**< zbus_chan_pub returned */
+	LATENCY_STAGE_COUNT,
+};
+
+#if defined(CONFIG_APP_LATENCY_TRACE)
+/**
+ * @brief Start a trace on the calling thread
+ *
+ * A trace that is not ended, e.g. on an error return, is dropped by the
+ * next call.
+ */
+void latency_trace_begin(enum latency_path path);
+
+/**
+ * @brief Timestamp a stage of the trace running on the calling thread
+ */
+void latency_trace_mark(enum latency_stage stage);
+
+/**
+ * @brief Close the trace and add it to the histograms
+ *
+ * @param path Path being traced
+ * @param tag LED or button number, reported with the trace
+ */
+void latency_trace_end(enum latency_path path, uint8_t tag);
+
+/**
+ * @brief Write the next fragment of the latency report as JSON
+ *
+ * @param buf Buffer for the fragment
+ * @param buf_len Buffer length
+ * @param cursor Position in the report, 0 for the first call
+ * @param done Set when the report is complete
+ * @return Number of bytes written, or negative error code
+ */
+int latency_trace_json_chunk(char *buf, size_t buf_len, uint32_t *cursor,
+			     bool *done);
+#else
+static inline void latency_trace_begin(enum latency_path path)
+{
+	ARG_UNUSED(path);
+}
+
+static inline void latency_trace_mark(enum latency_stage stage)
+{
+	ARG_UNUSED(stage);
+}
+
+static inline void latency_trace_end(enum latency_path path, uint8_t tag)
+{
+	ARG_UNUSED(path);
+	ARG_UNUSED(tag);
+}
+#endif /* CONFIG_APP_LATENCY_TRACE */
+
+#endif /* LATENCY_TRACE_H */
@@ -5,13 +5,16 @@
  */
 
 #include "led.h"
+#include "../app_trace.h"
+#include "../latency/latency_trace.h"
 #include "../messages.h"
+#include "../state_store/state_store.h"
+#include "../zbus_stats/zbus_stats.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(led_module, CONFIG_LED_MODULE_LOG_LEVEL);
 
 #include <dk_buttons_and_leds.h>
-#include <stdio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/smf.h>
 #include <zephyr/zbus/zbus.h>
@@ -71,7 +74,9 @@ static void led_off_entry(void *obj)
 	struct led_state_msg state_msg;
 
 	/* Turn LED off */
+	latency_trace_mark(LATENCY_LED_SMF);
 	dk_set_led_off(sm->led_number);
+	latency_trace_mark(LATENCY_LED_GPIO);
 	sm->is_on = false;
 
 	const char *label = app_led_label(sm->led_number);
@@ -80,7 +85,9 @@ static void led_off_entry(void *obj)
 	/* Publish state */
 	state_msg.led_number = sm->led_number;
 	state_msg.is_on = false;
-	zbus_chan_pub(&LED_STATE_CHAN, &state_msg, K_NO_WAIT);
+	APP_TRACE_BEGIN("led_state_pub", sm->led_number);
+	zbus_stats_pub(&LED_STATE_CHAN, &state_msg, K_NO_WAIT);
+	APP_TRACE_END("led_state_pub", sm->led_number);
 }
 
 static enum smf_state_result led_off_run(void *obj)
@@ -105,7 +112,9 @@ static void led_on_entry(void *obj)
 	struct led_state_msg state_msg;
 
 	/* Turn LED on */
+	latency_trace_mark(LATENCY_LED_SMF);
 	dk_set_led_on(sm->led_number);
+	latency_trace_mark(LATENCY_LED_GPIO);
 	sm->is_on = true;
 
 	const char *label = app_led_label(sm->led_number);
@@ -114,7 +123,9 @@ static void led_on_entry(void *obj)
 	/* Publish state */
 	state_msg.led_number = sm->led_number;
 	state_msg.is_on = true;
-	zbus_chan_pub(&LED_STATE_CHAN, &state_msg, K_NO_WAIT);
+	APP_TRACE_BEGIN("led_state_pub", sm->led_number);
+	zbus_stats_pub(&LED_STATE_CHAN, &state_msg, K_NO_WAIT);
+	APP_TRACE_END("led_state_pub", sm->led_number);
 }
 
 static enum smf_state_result led_on_run(void *obj)
@@ -142,6 +153,8 @@ static void led_cmd_listener(const struct zbus_channel *chan)
 {
 	const struct led_msg *msg = zbus_chan_const_msg(chan);
 
+	latency_trace_mark(LATENCY_LED_LISTENER);
+
 	if (msg->led_number >= NUM_LEDS) {
 		LOG_WRN("Invalid LED number: %d (max: %d)", msg->led_number,
 			NUM_LEDS - 1);
@@ -154,13 +167,15 @@ static void led_cmd_listener(const struct zbus_channel *chan)
 	sm->has_pending_command = true;
 
 	/* Run state machine */
+	APP_TRACE_BEGIN("led_smf", msg->led_number);
 	int ret = smf_run_state(SMF_CTX(sm));
+	APP_TRACE_END("led_smf", msg->led_number);
 	if (ret < 0) {
 		LOG_ERR("LED SM error: %d", ret);
 	}
 }
 
-ZBUS_LISTENER_DEFINE(led_cmd_listener_def, led_cmd_listener);
+ZBUS_STATS_LISTENER_DEFINE(led_cmd_listener_def, led_cmd_listener);
 ZBUS_CHAN_ADD_OBS(LED_CMD_CHAN, led_cmd_listener_def, 0);
 
 /* ============================================================================
@@ -178,43 +193,6 @@ int led_get_state(uint8_t led_number, bool *state)
 	return 0;
 }
 
-int led_get_all_states_json(char *buf, size_t buf_len)
-{
-	if (!buf || buf_len == 0) {
-		return -EINVAL;
-	}
-
-	int offset = 0;
-	int remaining = buf_len;
-	int written = snprintf(buf, remaining, "{\"leds\":[");
-	if (written < 0 || written >= remaining) {
-		return -ENOMEM;
-	}
-	offset += written;
-	remaining -= written;
-
-	for (int i = 0; i < NUM_LEDS; i++) {
-		bool is_last = (i == NUM_LEDS - 1);
-		const char *led_name = app_led_label(i);
-		written = snprintf(
-			buf + offset, remaining,
-			"{\"number\":%d,\"name\":\"%s\",\"is_on\":%s}%s", i,
-			led_name ? led_name : "",
-			led_sm[i].is_on ? "true" : "false", is_last ? "" : ",");
-		if (written < 0 || written >= remaining) {
-			return -ENOMEM;
-		}
-		offset += written;
-		remaining -= written;
-	}
-
-	written = snprintf(buf + offset, remaining, "]}");
-	if (written < 0 || written >= remaining) {
-		return -ENOMEM;
-	}
-	return offset + written;
-}
-
 /* ============================================================================
  * MODULE INITIALIZATION
  * ============================================================================
@@ -233,13 +211,20 @@ int led_module_init(void)
 		return ret;
 	}
 
+	state_store_load();
+
 	/* Initialize state machines for each LED */
 	for (int i = 0; i < NUM_LEDS; i++) {
+		bool is_on = false;
+
+		/* Start in the persisted state, off if none is stored */
+		state_store_led_get(i, &is_on);
+
 		led_sm[i].led_number = i;
-		led_sm[i].is_on = false;
+		led_sm[i].is_on = is_on;
 		led_sm[i].has_pending_command = false;
 
-		smf_set_initial(SMF_CTX(&led_sm[i]), &led_states[0]);
+		smf_set_initial(SMF_CTX(&led_sm[i]), &led_states[is_on ? 1 : 0]);
 
 		/* Run initial state */
 		smf_run_state(SMF_CTX(&led_sm[i]));
@@ -29,12 +29,4 @@ int led_module_init(void);
  */
 int led_get_state(uint8_t led_number, bool *state);
 
-/**
- * @brief Get all LED states as JSON
- * @param buf Buffer to store JSON string
- * @param buf_len Buffer length
- * @return Number of bytes written, or negative error code
- */
-int led_get_all_states_json(char *buf, size_t buf_len);
-
 #endif /* LED_H */
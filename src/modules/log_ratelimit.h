@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file log_ratelimit.h
+ * @brief Per-call-site rate-limited logging for module hot paths
+ *
+ * Each macro expansion owns its own window, so a flood from one call site
+ * never hides messages from another. Messages inside the window are
+ * counted and the count is reported with the next message that passes.
+ * The module must have called LOG_MODULE_REGISTER() before use.
+ */
+
+#ifndef LOG_RATELIMIT_H
+#define LOG_RATELIMIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#define APP_LOG_RATELIMIT(_log_macro, _interval_ms, ...)                       \
+	do {                                                                   \
+		static uint32_t _rl_last;                                      \
+		static uint32_t _rl_suppressed;                                \
+		static bool _rl_armed;                                         \
+		const uint32_t _rl_now = k_uptime_get_32();                    \
+									       \
+		if ((_interval_ms) == 0 || !_rl_armed ||                       \
+		    (_rl_now - _rl_last) >= (uint32_t)(_interval_ms)) {        \
+			if (_rl_suppressed > 0U) {                             \
+				_log_macro("(%u similar messages suppressed)", \
+					   _rl_suppressed);                    \
+			}                                                      \
+			_log_macro(__VA_ARGS__);                               \
+			_rl_last = _rl_now;                                    \
+			_rl_suppressed = 0U;                                   \
+			_rl_armed = true;                                      \
+		} else {                                                       \
+			_rl_suppressed++;                                      \
+		}                                                              \
+	} while (0)
+
+/** Rate-limited variants using CONFIG_APP_LOG_RATELIMIT_MS */
+#define APP_LOG_ERR_RL(...)                                                    \
+	APP_LOG_RATELIMIT(LOG_ERR, CONFIG_APP_LOG_RATELIMIT_MS, __VA_ARGS__)
+#define APP_LOG_WRN_RL(...)                                                    \
+	APP_LOG_RATELIMIT(LOG_WRN, CONFIG_APP_LOG_RATELIMIT_MS, __VA_ARGS__)
+#define APP_LOG_INF_RL(...)                                                    \
+	APP_LOG_RATELIMIT(LOG_INF, CONFIG_APP_LOG_RATELIMIT_MS, __VA_ARGS__)
+
+#endif /* LOG_RATELIMIT_H */
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "log_ring.h"
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+
+#define RING_SIZE CONFIG_APP_LOG_RING_SIZE
+
+/* ============================================================================
+ * RING STORAGE
+ * ============================================================================
+ */
+
+static char ring[RING_SIZE];
+static uint32_t ring_head;
+static struct k_spinlock ring_lock;
+
+static void ring_write(const uint8_t *data, size_t length)
+{
+	k_spinlock_key_t key;
+
+	/* Only the newest RING_SIZE bytes can survive */
+	if (length > RING_SIZE) {
+		data += length - RING_SIZE;
+		length = RING_SIZE;
+	}
+
+	key = k_spin_lock(&ring_lock);
+
+	size_t idx = ring_head % RING_SIZE;
+	size_t first = MIN(length, RING_SIZE - idx);
+
+	memcpy(&ring[idx], data, first);
+	memcpy(ring, data + first, length - first);
+	ring_head += length;
+
+	k_spin_unlock(&ring_lock, key);
+}
+
+static uint32_t tail_locked(void)
+{
+	return (ring_head > RING_SIZE) ? (ring_head - RING_SIZE) : 0U;
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+uint32_t log_ring_head(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+	uint32_t head = ring_head;
+
+	k_spin_unlock(&ring_lock, key);
+	return head;
+}
+
+uint32_t log_ring_tail(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&ring_lock);
+	uint32_t tail = tail_locked();
+
+	k_spin_unlock(&ring_lock, key);
+	return tail;
+}
+
+size_t log_ring_read(uint32_t *pos, char *buf, size_t buf_len)
+{
+	k_spinlock_key_t key;
+	size_t copied = 0;
+
+	if (!pos || !buf || buf_len == 0) {
+		return 0;
+	}
+
+	key = k_spin_lock(&ring_lock);
+
+	uint32_t tail = tail_locked();
+
+	if (*pos < tail) {
+		/* Overwritten: skip the partial record at the tail */
+		*pos = tail;
+		while (*pos < ring_head && ring[*pos % RING_SIZE] != '\n') {
+			(*pos)++;
+		}
+		if (*pos < ring_head) {
+			(*pos)++;
+		}
+	}
+
+	if (*pos < ring_head) {
+		size_t length = MIN(buf_len, ring_head - *pos);
+		size_t idx = *pos % RING_SIZE;
+		size_t first = MIN(length, RING_SIZE - idx);
+
+		memcpy(buf, &ring[idx], first);
+		memcpy(buf + first, ring, length - first);
+		*pos += length;
+		copied = length;
+	}
+
+	k_spin_unlock(&ring_lock, key);
+
+	return copied;
+}
+
+/* ============================================================================
+ * LOG BACKEND
+ * ============================================================================
+ */
+
+static int ring_output_func(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	ring_write(data, length);
+	return length;
+}
+
+static uint8_t ring_output_buf[CONFIG_APP_LOG_RING_LINE_BUF_SIZE];
+LOG_OUTPUT_DEFINE(log_ring_output, ring_output_func, ring_output_buf,
+		  sizeof(ring_output_buf));
+
+static void log_ring_process(const struct log_backend *const backend,
+			     union log_msg_generic *msg)
+{
+	const uint32_t flags = LOG_OUTPUT_FLAG_LEVEL |
+			       LOG_OUTPUT_FLAG_TIMESTAMP |
+			       LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP |
+			       LOG_OUTPUT_FLAG_CRLF_LFONLY;
+
+	ARG_UNUSED(backend);
+
+	log_output_msg_process(&log_ring_output, &msg->log, flags);
+}
+
+static void log_ring_dropped(const struct log_backend *const backend,
+			     uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	log_output_dropped_process(&log_ring_output, cnt);
+}
+
+static void log_ring_panic(const struct log_backend *const backend)
+{
+	ARG_UNUSED(backend);
+
+	log_output_flush(&log_ring_output);
+}
+
+static const struct log_backend_api log_ring_api = {
+	.process = log_ring_process,
+	.dropped = log_ring_dropped,
+	.panic = log_ring_panic,
+};
+
+LOG_BACKEND_DEFINE(log_backend_ring, log_ring_api, true);
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file log_ring.h
+ * @brief In-memory log ring backend
+ *
+ * Positions are absolute byte offsets since boot. A reader keeps its own
+ * position, so any number of readers can walk the ring without consuming
+ * records.
+ */
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Get the position of the next byte to be written
+ * @return Absolute write position
+ */
+uint32_t log_ring_head(void);
+
+/**
+ * @brief Get the position of the oldest byte still held in the ring
+ * @return Absolute position of the oldest byte
+ */
+uint32_t log_ring_tail(void);
+
+/**
+ * @brief Copy log text starting at a position
+ *
+ * If *pos has already been overwritten, reading resumes at the first
+ * complete record still in the ring.
+ *
+ * @param pos Read position, advanced past the copied bytes
+ * @param buf Destination buffer
+ * @param buf_len Destination buffer length
+ * @return Number of bytes copied
+ */
+size_t log_ring_read(uint32_t *pos, char *buf, size_t buf_len);
+
+#endif /* LOG_RING_H */
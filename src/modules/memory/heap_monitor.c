@@ -3,6 +3,9 @@
  * Copyright (c) 2026 Nordic Semiconductor ASA
  */
 
+#include "heap_monitor.h"
+
+#include <errno.h>
 #include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -71,6 +74,27 @@ static void heap_report(const char *trigger)
 	}
 }
 
+int heap_monitor_free_get(size_t *free_bytes, size_t *total_bytes)
+{
+	struct sys_memory_stats stats;
+	int ret;
+
+	if (!free_bytes || !total_bytes) {
+		return -EINVAL;
+	}
+
+	ret = sys_heap_runtime_stats_get((struct sys_heap *)&_system_heap.heap,
+					 &stats);
+	if (ret != 0) {
+		return ret;
+	}
+
+	*free_bytes = stats.free_bytes;
+	*total_bytes = stats.allocated_bytes + stats.free_bytes;
+
+	return 0;
+}
+
 static void heap_listener_alloc(uintptr_t heap_id, void *mem, size_t bytes)
 {
 	ARG_UNUSED(mem);
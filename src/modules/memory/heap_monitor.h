@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file heap_monitor.h
+ * @brief System heap usage as tracked by the heap monitor
+ */
+
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <stddef.h>
+
+/**
+ * @brief Get the current system heap usage
+ *
+ * Reads the heap's runtime counters; does not walk the heap.
+ *
+ * @param free_bytes Bytes currently free
+ * @param total_bytes Heap size
+ * @return 0 on success, negative error code otherwise
+ */
+int heap_monitor_free_get(size_t *free_bytes, size_t *total_bytes);
+
+#endif /* HEAP_MONITOR_H */
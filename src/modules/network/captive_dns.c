@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/*
+ * Captive-portal DNS responder. Every A query is answered with the SoftAP
+ * address, every other type gets an empty NOERROR answer so clients do not
+ * wait for a timeout. Responses are the request header and question with
+ * a prebuilt answer record appended.
+ */
+
+#include "network.h"
+
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/socket_service.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_DECLARE(network_module, CONFIG_NETWORK_MODULE_LOG_LEVEL);
+
+#define DNS_PORT        53
+#define DNS_HEADER_LEN  12
+#define DNS_ANSWER_LEN  16
+#define DNS_MAX_MSG_LEN 512
+
+#define DNS_TYPE_A   1
+#define DNS_TYPE_ANY 255
+#define DNS_CLASS_IN 1
+
+/* Header flag bits */
+#define DNS_FLAG_QR     BIT(15)
+#define DNS_FLAG_OPCODE (0xFU << 11)
+#define DNS_FLAG_AA     BIT(10)
+#define DNS_FLAG_RD     BIT(8)
+#define DNS_FLAG_RA     BIT(7)
+
+#define DNS_RCODE_NOTIMP 4
+
+/* Answer record: name pointer to the question, A, IN, TTL, 4-byte address */
+static uint8_t answer_template[DNS_ANSWER_LEN];
+
+static uint8_t dns_buf[DNS_MAX_MSG_LEN];
+static int dns_sock = -1;
+static atomic_t dns_started;
+
+static void dns_handler(struct net_socket_service_event *pev);
+
+NET_SOCKET_SERVICE_SYNC_DEFINE_STATIC(captive_dns_service, dns_handler, 1);
+
+static void answer_template_init(const struct in_addr *addr)
+{
+	uint8_t *p = answer_template;
+
+	sys_put_be16(0xC000 | DNS_HEADER_LEN, p);
+	sys_put_be16(DNS_TYPE_A, p + 2);
+	sys_put_be16(DNS_CLASS_IN, p + 4);
+	sys_put_be32(CONFIG_NETWORK_CAPTIVE_DNS_TTL, p + 6);
+	sys_put_be16(sizeof(struct in_addr), p + 10);
+	memcpy(p + 12, addr, sizeof(struct in_addr));
+}
+
+/* Returns the length of the question section, or negative if malformed */
+static int question_len(const uint8_t *msg, size_t len, uint16_t *qtype)
+{
+	size_t pos = DNS_HEADER_LEN;
+
+	while (pos < len && msg[pos] != 0) {
+		/* Compression pointers are not valid in a query name */
+		if (msg[pos] & 0xC0) {
+			return -EINVAL;
+		}
+		pos += msg[pos] + 1;
+	}
+
+	/* Zero label, QTYPE and QCLASS */
+	if (pos + 5 > len) {
+		return -EINVAL;
+	}
+
+	*qtype = sys_get_be16(&msg[pos + 1]);
+
+	return pos + 5 - DNS_HEADER_LEN;
+}
+
+/* Turns the query in buf into a response, returns the response length */
+static int dns_build_response(uint8_t *buf, size_t len)
+{
+	uint16_t flags = sys_get_be16(&buf[2]);
+	uint16_t qtype;
+	uint16_t ancount = 0;
+	int qlen;
+
+	if (len < DNS_HEADER_LEN || (flags & DNS_FLAG_QR)) {
+		return -EINVAL;
+	}
+
+	/* Header and one question are kept, other sections are dropped */
+	sys_put_be16(0, &buf[8]);
+	sys_put_be16(0, &buf[10]);
+
+	/* Only standard queries with a single question are answered */
+	if ((flags & DNS_FLAG_OPCODE) != 0 || sys_get_be16(&buf[4]) != 1) {
+		flags &= DNS_FLAG_OPCODE | DNS_FLAG_RD;
+		sys_put_be16(DNS_FLAG_QR | flags | DNS_RCODE_NOTIMP, &buf[2]);
+		sys_put_be16(0, &buf[4]);
+		sys_put_be16(0, &buf[6]);
+		return DNS_HEADER_LEN;
+	}
+
+	qlen = question_len(buf, len, &qtype);
+	if (qlen < 0) {
+		return qlen;
+	}
+
+	len = DNS_HEADER_LEN + qlen;
+
+	if (qtype == DNS_TYPE_A || qtype == DNS_TYPE_ANY) {
+		memcpy(&buf[len], answer_template, DNS_ANSWER_LEN);
+		len += DNS_ANSWER_LEN;
+		ancount = 1;
+	}
+
+	sys_put_be16(DNS_FLAG_QR | DNS_FLAG_AA | DNS_FLAG_RA |
+			     (flags & DNS_FLAG_RD),
+		     &buf[2]);
+	sys_put_be16(ancount, &buf[6]);
+
+	return len;
+}
+
+static void dns_handler(struct net_socket_service_event *pev)
+{
+	struct sockaddr_in client;
+	socklen_t client_len = sizeof(client);
+	ssize_t received;
+	int len;
+
+	/* Leave room for the answer behind the largest accepted query */
+	received = zsock_recvfrom(pev->event.fd, dns_buf,
+				  sizeof(dns_buf) - DNS_ANSWER_LEN, 0,
+				  (struct sockaddr *)&client, &client_len);
+	if (received <= 0) {
+		return;
+	}
+
+	len = dns_build_response(dns_buf, received);
+	if (len < 0) {
+		LOG_DBG("Malformed DNS query dropped");
+		return;
+	}
+
+	(void)zsock_sendto(pev->event.fd, dns_buf, len, 0,
+			   (struct sockaddr *)&client, client_len);
+}
+
+int network_captive_dns_start(void)
+{
+	static struct zsock_pollfd fds[1];
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(DNS_PORT),
+		.sin_addr = INADDR_ANY_INIT,
+	};
+	struct in_addr ap_addr;
+	int ret;
+
+	if (atomic_set(&dns_started, 1)) {
+		return 0;
+	}
+
+	if (zsock_inet_pton(AF_INET, CONFIG_NET_CONFIG_MY_IPV4_ADDR,
+			    &ap_addr) != 1) {
+		ret = -EINVAL;
+		goto fail;
+	}
+	answer_template_init(&ap_addr);
+
+	dns_sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (dns_sock < 0) {
+		ret = -errno;
+		goto fail;
+	}
+
+	if (zsock_bind(dns_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		ret = -errno;
+		goto fail_close;
+	}
+
+	fds[0].fd = dns_sock;
+	fds[0].events = ZSOCK_POLLIN;
+
+	ret = net_socket_service_register(&captive_dns_service, fds,
+					  ARRAY_SIZE(fds), NULL);
+	if (ret < 0) {
+		goto fail_close;
+	}
+
+	LOG_INF("Captive DNS responder answering with %s",
+		CONFIG_NET_CONFIG_MY_IPV4_ADDR);
+	return 0;
+
+fail_close:
+	zsock_close(dns_sock);
+	dns_sock = -1;
+fail:
+	LOG_ERR("Failed to start captive DNS responder: %d", ret);
+	atomic_set(&dns_started, 0);
+	return ret;
+}
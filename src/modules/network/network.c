@@ -5,29 +5,46 @@
  */
 
 #include "network.h"
+#include "../boot/boot_timeline.h"
+#include <stdio.h>
+#include <string.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/net/dhcpv4_server.h>
 #include <zephyr/net/net_event.h>
 #include <zephyr/net/net_if.h>
 #include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_pkt_filter.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/wifi_mgmt.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+
+#if defined(CONFIG_WIFI_NM_WPA_SUPPLICANT)
+#include <supp_events.h>
+#endif
 
 LOG_MODULE_REGISTER(network_module, CONFIG_NETWORK_MODULE_LOG_LEVEL);
 
 /* Event masks */
 #define L2_IF_EVENT_MASK (NET_EVENT_IF_DOWN | NET_EVENT_IF_UP)
 #define L2_SOFTAP_EVENT_MASK                                                   \
-	(NET_EVENT_WIFI_AP_ENABLE_RESULT | NET_EVENT_WIFI_AP_STA_CONNECTED |   \
-	 NET_EVENT_WIFI_AP_STA_DISCONNECTED)
+	(NET_EVENT_WIFI_AP_ENABLE_RESULT | NET_EVENT_WIFI_AP_DISABLE_RESULT |  \
+	 NET_EVENT_WIFI_AP_STA_CONNECTED | NET_EVENT_WIFI_AP_STA_DISCONNECTED)
 
 /* Semaphores for network events */
 static K_SEM_DEFINE(iface_up_sem, 0, 1);
 static K_SEM_DEFINE(softap_ready_sem, 0, 1);
 static K_SEM_DEFINE(station_connected_sem, 0, 1);
+static K_SEM_DEFINE(supplicant_ready_sem, 0, 1);
+static atomic_t supplicant_ready;
 
 /* Network event callbacks */
 static struct net_mgmt_event_callback iface_event_cb;
 static struct net_mgmt_event_callback softap_event_cb;
+#if defined(CONFIG_WIFI_NM_WPA_SUPPLICANT)
+static struct net_mgmt_event_callback supplicant_event_cb;
+#endif
 
 /* Station tracking */
 #define MAX_SOFTAP_STATIONS 4
@@ -36,11 +53,201 @@ struct softap_station {
 	bool valid;
 	uint8_t mac[6];
 	struct in_addr ip_addr;
+	int64_t assoc_time;
+	enum wifi_link_mode link_mode;
 };
 
 static struct softap_station connected_stations[MAX_SOFTAP_STATIONS];
 static K_MUTEX_DEFINE(station_mutex);
 
+#if defined(CONFIG_NET_DHCPV4_SERVER)
+struct lease_lookup {
+	const uint8_t *mac;
+	struct in_addr addr;
+};
+
+static void lease_match(struct net_if *iface, struct dhcpv4_addr_slot *lease,
+			void *user_data)
+{
+	struct lease_lookup *lookup = user_data;
+
+	ARG_UNUSED(iface);
+
+	/* Client identifier is hardware type 1 (Ethernet) followed by MAC */
+	if (lease->state != DHCPV4_SERVER_ADDR_ALLOCATED ||
+	    lease->client_id.len != 7 || lease->client_id.buf[0] != 1 ||
+	    memcmp(&lease->client_id.buf[1], lookup->mac, 6) != 0) {
+		return;
+	}
+
+	lookup->addr = lease->addr;
+}
+
+int network_lease_addr_get(struct net_if *iface, const uint8_t *mac,
+			   struct in_addr *addr)
+{
+	struct lease_lookup lookup = {.mac = mac};
+
+	if (!iface || !mac || !addr) {
+		return -EINVAL;
+	}
+
+	net_dhcpv4_server_foreach_lease(iface, lease_match, &lookup);
+	if (lookup.addr.s_addr == 0) {
+		return -ENOENT;
+	}
+
+	*addr = lookup.addr;
+	return 0;
+}
+#endif /* CONFIG_NET_DHCPV4_SERVER */
+
+#if defined(CONFIG_NETWORK_STATION_STATS)
+/* Traffic counters, updated from the RX/TX paths by IPv4 address */
+struct station_counters {
+	struct in_addr ip_addr;
+	uint32_t tx_bytes;
+	uint32_t tx_packets;
+	uint32_t rx_bytes;
+	uint32_t rx_packets;
+};
+
+static struct station_counters station_counters[MAX_SOFTAP_STATIONS];
+static struct k_spinlock counters_lock;
+
+/* Snapshot served to API readers, rebuilt by station_refresh_work */
+struct station_snapshot {
+	struct softap_station station;
+	struct station_counters counters;
+};
+
+static struct station_snapshot station_snapshot[MAX_SOFTAP_STATIONS];
+static int64_t snapshot_time;
+static K_MUTEX_DEFINE(snapshot_mutex);
+
+static void station_counters_reset(int slot, const struct in_addr *ip_addr)
+{
+	k_spinlock_key_t key = k_spin_lock(&counters_lock);
+
+	memset(&station_counters[slot], 0, sizeof(station_counters[slot]));
+	if (ip_addr) {
+		station_counters[slot].ip_addr = *ip_addr;
+	}
+
+	k_spin_unlock(&counters_lock, key);
+}
+
+static void station_count(const uint8_t *addr, size_t len, bool tx)
+{
+	k_spinlock_key_t key = k_spin_lock(&counters_lock);
+
+	for (int i = 0; i < MAX_SOFTAP_STATIONS; i++) {
+		struct station_counters *counters = &station_counters[i];
+
+		if (counters->ip_addr.s_addr == 0 ||
+		    memcmp(&counters->ip_addr, addr, sizeof(struct in_addr))) {
+			continue;
+		}
+
+		if (tx) {
+			counters->tx_bytes += len;
+			counters->tx_packets++;
+		} else {
+			counters->rx_bytes += len;
+			counters->rx_packets++;
+		}
+		break;
+	}
+
+	k_spin_unlock(&counters_lock, key);
+}
+
+/* Filter tests only observe packets and never match */
+static bool station_count_tx(struct npf_test *test, struct net_pkt *pkt)
+{
+	ARG_UNUSED(test);
+
+	if (net_pkt_family(pkt) == AF_INET) {
+		station_count(NET_IPV4_HDR(pkt)->dst, net_pkt_get_len(pkt),
+			      true);
+	}
+
+	return false;
+}
+
+static bool station_count_rx(struct npf_test *test, struct net_pkt *pkt)
+{
+	ARG_UNUSED(test);
+
+	station_count(NET_IPV4_HDR(pkt)->src, net_pkt_get_len(pkt), false);
+
+	return false;
+}
+
+static struct npf_test station_tx_test = {.fn = station_count_tx};
+static struct npf_test station_rx_test = {.fn = station_count_rx};
+
+static NPF_RULE(station_tx_rule, NET_OK, station_tx_test);
+static NPF_RULE(station_rx_rule, NET_OK, station_rx_test);
+
+static void station_refresh_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(station_refresh_work, station_refresh_fn);
+
+static void station_refresh_fn(struct k_work *work)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	bool any_valid = false;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&station_mutex, K_FOREVER);
+	k_mutex_lock(&snapshot_mutex, K_FOREVER);
+
+	for (int i = 0; i < MAX_SOFTAP_STATIONS; i++) {
+		struct softap_station *sta = &connected_stations[i];
+		k_spinlock_key_t key;
+
+		if (sta->valid && sta->ip_addr.s_addr == 0 && iface) {
+			if (network_lease_addr_get(iface, sta->mac,
+						   &sta->ip_addr) == 0) {
+				station_counters_reset(i, &sta->ip_addr);
+			}
+		}
+
+		station_snapshot[i].station = *sta;
+		key = k_spin_lock(&counters_lock);
+		station_snapshot[i].counters = station_counters[i];
+		k_spin_unlock(&counters_lock, key);
+
+		any_valid |= sta->valid;
+	}
+
+	snapshot_time = k_uptime_get();
+
+	k_mutex_unlock(&snapshot_mutex);
+	k_mutex_unlock(&station_mutex);
+
+	/* Keep refreshing while anyone is associated */
+	if (any_valid) {
+		k_work_reschedule(
+			&station_refresh_work,
+			K_MSEC(CONFIG_NETWORK_STATION_STATS_REFRESH_MS));
+	}
+}
+#endif /* CONFIG_NETWORK_STATION_STATS */
+
+#if defined(CONFIG_NETWORK_CAPTIVE_DNS)
+static void captive_dns_start_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	network_captive_dns_start();
+}
+
+static K_WORK_DEFINE(captive_dns_start_work, captive_dns_start_fn);
+#endif
+
 static void iface_event_handler(struct net_mgmt_event_callback *cb,
 				uint64_t mgmt_event, struct net_if *iface)
 {
@@ -50,6 +257,7 @@ static void iface_event_handler(struct net_mgmt_event_callback *cb,
 	case NET_EVENT_IF_UP:
 		net_if_get_name(iface, ifname, sizeof(ifname) - 1);
 		LOG_INF("Network interface %s is UP", ifname);
+		boot_timeline_mark(BOOT_PHASE_IFACE_UP);
 		k_sem_give(&iface_up_sem);
 		break;
 
@@ -77,11 +285,30 @@ static void softap_event_handler(struct net_mgmt_event_callback *cb,
 		if (status->status == 0) {
 			LOG_INF("SoftAP enabled successfully");
 			k_sem_give(&softap_ready_sem);
+#if defined(CONFIG_NETWORK_CAPTIVE_DNS)
+			/* Socket setup stays off the net_mgmt event thread */
+			k_work_submit(&captive_dns_start_work);
+#endif
 		} else {
 			LOG_ERR("SoftAP enable failed: %d", status->status);
 		}
 		break;
 
+	case NET_EVENT_WIFI_AP_DISABLE_RESULT:
+		/* Stations are dropped without individual disconnect events */
+		k_mutex_lock(&station_mutex, K_FOREVER);
+		memset(connected_stations, 0, sizeof(connected_stations));
+		k_mutex_unlock(&station_mutex);
+
+#if defined(CONFIG_NETWORK_STATION_STATS)
+		for (int i = 0; i < MAX_SOFTAP_STATIONS; i++) {
+			station_counters_reset(i, NULL);
+		}
+		k_work_reschedule(&station_refresh_work, K_NO_WAIT);
+#endif
+		LOG_INF("SoftAP disabled, station table cleared");
+		break;
+
 	case NET_EVENT_WIFI_AP_STA_CONNECTED:
 		sta_info = (const struct wifi_ap_sta_info *)cb->info;
 
@@ -99,6 +326,10 @@ static void softap_event_handler(struct net_mgmt_event_callback *cb,
 				connected_stations[i].valid = true;
 				memcpy(connected_stations[i].mac, sta_info->mac,
 				       6);
+				connected_stations[i].assoc_time =
+					k_uptime_get();
+				connected_stations[i].link_mode =
+					sta_info->link_mode;
 				slot = i;
 				break;
 			}
@@ -107,6 +338,11 @@ static void softap_event_handler(struct net_mgmt_event_callback *cb,
 
 		if (slot >= 0) {
 			LOG_DBG("Station stored in slot %d", slot);
+#if defined(CONFIG_NETWORK_STATION_STATS)
+			station_counters_reset(slot, NULL);
+			/* DHCP completes shortly after association */
+			k_work_reschedule(&station_refresh_work, K_NO_WAIT);
+#endif
 		}
 
 		k_sem_give(&station_connected_sem);
@@ -131,10 +367,18 @@ static void softap_event_handler(struct net_mgmt_event_callback *cb,
 				connected_stations[i].valid = false;
 				memset(&connected_stations[i], 0,
 				       sizeof(struct softap_station));
+				slot = i;
 				break;
 			}
 		}
 		k_mutex_unlock(&station_mutex);
+
+#if defined(CONFIG_NETWORK_STATION_STATS)
+		if (slot >= 0) {
+			station_counters_reset(slot, NULL);
+			k_work_reschedule(&station_refresh_work, K_NO_WAIT);
+		}
+#endif
 		break;
 
 	default:
@@ -142,11 +386,45 @@ static void softap_event_handler(struct net_mgmt_event_callback *cb,
 	}
 }
 
+#if defined(CONFIG_WIFI_NM_WPA_SUPPLICANT)
+static void supplicant_event_handler(struct net_mgmt_event_callback *cb,
+				     uint64_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(cb);
+	ARG_UNUSED(iface);
+
+	if (mgmt_event == NET_EVENT_SUPPLICANT_READY) {
+		LOG_INF("WPA supplicant ready");
+		boot_timeline_mark(BOOT_PHASE_SUPPLICANT_READY);
+		atomic_set(&supplicant_ready, 1);
+		k_sem_give(&supplicant_ready_sem);
+	}
+}
+#endif
+
 int network_wait_for_iface_up(k_timeout_t timeout)
 {
+	struct net_if *iface = net_if_get_first_wifi();
+
+	/* The interface may have come up before the callback was added */
+	if (iface && net_if_is_up(iface)) {
+		boot_timeline_mark(BOOT_PHASE_IFACE_UP);
+		return 0;
+	}
+
 	return k_sem_take(&iface_up_sem, timeout);
 }
 
+int network_wait_for_supplicant_ready(k_timeout_t timeout)
+{
+	if (!IS_ENABLED(CONFIG_WIFI_NM_WPA_SUPPLICANT) ||
+	    atomic_get(&supplicant_ready)) {
+		return 0;
+	}
+
+	return k_sem_take(&supplicant_ready_sem, timeout);
+}
+
 int network_wait_for_softap_ready(k_timeout_t timeout)
 {
 	return k_sem_take(&softap_ready_sem, timeout);
@@ -157,6 +435,79 @@ int network_wait_for_station_connected(k_timeout_t timeout)
 	return k_sem_take(&station_connected_sem, timeout);
 }
 
+#if defined(CONFIG_NETWORK_STATION_STATS)
+int network_stations_json(char *buf, size_t buf_len)
+{
+	const int64_t now = k_uptime_get();
+	bool first = true;
+
+	if (!buf || buf_len == 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&snapshot_mutex, K_FOREVER);
+
+	int offset = 0;
+	int remaining = buf_len;
+	int written = snprintf(buf, remaining,
+			       "{\"age_ms\":%u,\"stations\":[",
+			       (uint32_t)(now - snapshot_time));
+	if (written < 0 || written >= remaining) {
+		k_mutex_unlock(&snapshot_mutex);
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	for (int i = 0; i < MAX_SOFTAP_STATIONS; i++) {
+		const struct softap_station *sta = &station_snapshot[i].station;
+		const struct station_counters *counters =
+			&station_snapshot[i].counters;
+		char ip_str[NET_IPV4_ADDR_LEN] = "";
+
+		if (!sta->valid) {
+			continue;
+		}
+
+		if (sta->ip_addr.s_addr != 0) {
+			net_addr_ntop(AF_INET, &sta->ip_addr, ip_str,
+				      sizeof(ip_str));
+		}
+
+		/* AP station info carries no RSSI, so it is reported as null */
+		written = snprintf(
+			buf + offset, remaining,
+			/* clang-format off */
+			"%s{\"mac\":\"%02x:%02x:%02x:%02x:%02x:%02x\","
+			"\"ip\":\"%s\",\"link_mode\":\"%s\",\"rssi\":null,"
+			"\"connected_ms\":%u,\"tx_bytes\":%u,\"tx_packets\":%u,"
+			"\"rx_bytes\":%u,\"rx_packets\":%u}",
+			/* clang-format on */
+			first ? "" : ",", sta->mac[0], sta->mac[1], sta->mac[2],
+			sta->mac[3], sta->mac[4], sta->mac[5], ip_str,
+			wifi_link_mode_txt(sta->link_mode),
+			(uint32_t)(now - sta->assoc_time), counters->tx_bytes,
+			counters->tx_packets, counters->rx_bytes,
+			counters->rx_packets);
+		if (written < 0 || written >= remaining) {
+			k_mutex_unlock(&snapshot_mutex);
+			return -ENOMEM;
+		}
+		offset += written;
+		remaining -= written;
+		first = false;
+	}
+
+	k_mutex_unlock(&snapshot_mutex);
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	return offset + written;
+}
+#endif /* CONFIG_NETWORK_STATION_STATS */
+
 int network_module_init(void)
 {
 	LOG_INF("Initializing network module");
@@ -174,8 +525,24 @@ int network_module_init(void)
 				     L2_SOFTAP_EVENT_MASK);
 	net_mgmt_add_event_callback(&softap_event_cb);
 
+#if defined(CONFIG_WIFI_NM_WPA_SUPPLICANT)
+	net_mgmt_init_event_callback(&supplicant_event_cb,
+				     supplicant_event_handler,
+				     NET_EVENT_SUPPLICANT_READY);
+	net_mgmt_add_event_callback(&supplicant_event_cb);
+#endif
+
+#if defined(CONFIG_NETWORK_STATION_STATS)
+	/* Counting rules never match, the default rule accepts the packet */
+	npf_append_send_rule(&station_tx_rule);
+	npf_append_send_rule(&npf_default_ok);
+	npf_append_ipv4_recv_rule(&station_rx_rule);
+	npf_append_ipv4_recv_rule(&npf_default_ok);
+#endif
+
 	LOG_INF("Network module initialized");
 	return 0;
 }
 
-SYS_INIT(network_module_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+/* Register before the supplicant and interface can report readiness */
+SYS_INIT(network_module_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
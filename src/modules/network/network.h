@@ -7,7 +7,11 @@
 #ifndef NETWORK_H
 #define NETWORK_H
 
+#include <stddef.h>
 #include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+
+struct net_if;
 
 /**
  * @brief Initialize network event management module
@@ -19,11 +23,23 @@ int network_module_init(void);
 /**
  * @brief Wait for network interface to be up
  *
+ * Returns immediately if the WiFi interface is already up.
+ *
  * @param timeout Maximum time to wait
  * @return 0 on success, negative error code on timeout
  */
 int network_wait_for_iface_up(k_timeout_t timeout);
 
+/**
+ * @brief Wait for the WPA supplicant to be ready
+ *
+ * Returns immediately if the supplicant is already ready or not used.
+ *
+ * @param timeout Maximum time to wait
+ * @return 0 on success, negative error code on timeout
+ */
+int network_wait_for_supplicant_ready(k_timeout_t timeout);
+
 /**
  * @brief Wait for SoftAP to be enabled
  *
@@ -40,4 +56,43 @@ int network_wait_for_softap_ready(k_timeout_t timeout);
  */
 int network_wait_for_station_connected(k_timeout_t timeout);
 
+/**
+ * @brief Get the cached station table as JSON
+ *
+ * Reports MAC, DHCP-assigned IP, association time and per-station traffic
+ * counters of every associated station. The snapshot is refreshed every
+ * CONFIG_NETWORK_STATION_STATS_REFRESH_MS while stations are connected.
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int network_stations_json(char *buf, size_t buf_len);
+
+#if defined(CONFIG_NET_DHCPV4_SERVER)
+/**
+ * @brief Look up the address leased to a station
+ *
+ * @param iface Interface the DHCPv4 server runs on
+ * @param mac Station MAC address (6 bytes)
+ * @param addr Set to the leased address on success
+ * @return 0 on success, -ENOENT if the station holds no allocated lease,
+ *         -EINVAL on bad arguments
+ */
+int network_lease_addr_get(struct net_if *iface, const uint8_t *mac,
+			   struct in_addr *addr);
+#endif
+
+#if defined(CONFIG_NETWORK_CAPTIVE_DNS)
+/**
+ * @brief Start the captive-portal DNS responder
+ *
+ * Answers every A query on UDP port 53 with the SoftAP address. Started
+ * automatically once the SoftAP is enabled; later calls return 0.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int network_captive_dns_start(void);
+#endif
+
 #endif /* NETWORK_H */
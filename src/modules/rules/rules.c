@@ -0,0 +1,680 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "rules.h"
+#include "../event_loop/event_loop.h"
+#include "../messages.h"
+#include "../zbus_stats/zbus_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_rules, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include "../log_ratelimit.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/data/json.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/zbus/zbus.h>
+
+#define MAX_RULES CONFIG_APP_RULES_MAX
+
+BUILD_ASSERT(APP_NUM_LEDS <= 32, "LED states are tracked as a bitmask");
+
+extern const struct zbus_channel BUTTON_CHAN;
+extern const struct zbus_channel LED_CMD_CHAN;
+extern const struct zbus_channel LED_STATE_CHAN;
+
+enum rule_event {
+	RULE_EVENT_PRESS,
+	RULE_EVENT_RELEASE,
+	RULE_EVENT_COUNT,
+};
+
+enum rule_cond {
+	RULE_COND_ALWAYS,
+	RULE_COND_LED_ON,
+	RULE_COND_LED_OFF,
+	RULE_COND_EVERY,
+	RULE_COND_COUNT,
+};
+
+/* One group per button and event */
+#define GROUP_COUNT (APP_NUM_BUTTONS * RULE_EVENT_COUNT)
+
+/* Also the stored format, keep the layout stable */
+struct rule {
+	uint8_t button;
+	uint8_t event;
+	uint8_t cond;
+	/* LED for led_on and led_off, period for every */
+	uint8_t arg;
+	uint8_t led;
+	/* enum led_msg_type */
+	uint8_t action;
+};
+
+/* Rules sorted by group, in configured order within a group */
+struct rule_table {
+	/* Group g is rules[first[g]] up to rules[first[g + 1]] */
+	uint8_t first[GROUP_COUNT + 1];
+	struct rule rules[MAX_RULES];
+};
+
+struct rules_stats {
+	uint32_t evals;
+	uint32_t fired;
+	uint32_t failed;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+};
+
+static const char *const event_names[RULE_EVENT_COUNT] = {
+	[RULE_EVENT_PRESS] = "press",
+	[RULE_EVENT_RELEASE] = "release",
+};
+
+static const char *const cond_names[RULE_COND_COUNT] = {
+	[RULE_COND_ALWAYS] = "always",
+	[RULE_COND_LED_ON] = "led_on",
+	[RULE_COND_LED_OFF] = "led_off",
+	[RULE_COND_EVERY] = "every",
+};
+
+static const char *const action_names[] = {
+	[LED_COMMAND_ON] = "on",
+	[LED_COMMAND_OFF] = "off",
+	[LED_COMMAND_TOGGLE] = "toggle",
+};
+
+/* Rules in the order they were configured, for reporting and storage */
+static struct rule config[MAX_RULES];
+static size_t config_count;
+static struct rule_table table;
+static struct rules_stats stats;
+/* Held by the listener while it evaluates, so a new table is never seen
+ * half written
+ */
+static K_MUTEX_DEFINE(rules_mutex);
+
+/* Bit per LED, kept current from LED_STATE_CHAN */
+static atomic_t led_mask;
+
+/* ============================================================================
+ * EVALUATION
+ * ============================================================================
+ */
+
+static inline size_t rule_group(uint8_t button, uint8_t event)
+{
+	return button * RULE_EVENT_COUNT + event;
+}
+
+static bool rule_valid(const struct rule *rule)
+{
+	if (rule->button >= APP_NUM_BUTTONS || rule->led >= APP_NUM_LEDS ||
+	    rule->event >= RULE_EVENT_COUNT || rule->cond >= RULE_COND_COUNT ||
+	    rule->action >= ARRAY_SIZE(action_names)) {
+		return false;
+	}
+
+	switch (rule->cond) {
+	case RULE_COND_LED_ON:
+	case RULE_COND_LED_OFF:
+		return rule->arg < APP_NUM_LEDS;
+	case RULE_COND_EVERY:
+		return rule->arg > 0U;
+	default:
+		return true;
+	}
+}
+
+static void rules_compile(struct rule_table *out, const struct rule *rules,
+			  size_t count)
+{
+	uint8_t next[GROUP_COUNT];
+
+	memset(out->first, 0, sizeof(out->first));
+
+	for (size_t i = 0; i < count; i++) {
+		out->first[rule_group(rules[i].button, rules[i].event) + 1]++;
+	}
+
+	for (size_t g = 0; g < GROUP_COUNT; g++) {
+		out->first[g + 1] += out->first[g];
+	}
+
+	memcpy(next, out->first, sizeof(next));
+
+	for (size_t i = 0; i < count; i++) {
+		const size_t g = rule_group(rules[i].button, rules[i].event);
+
+		out->rules[next[g]++] = rules[i];
+	}
+}
+
+static bool rule_cond_met(const struct rule *rule, uint32_t press_count)
+{
+	switch (rule->cond) {
+	case RULE_COND_LED_ON:
+		return atomic_test_bit(&led_mask, rule->arg);
+	case RULE_COND_LED_OFF:
+		return !atomic_test_bit(&led_mask, rule->arg);
+	case RULE_COND_EVERY:
+		return (press_count % rule->arg) == 0U;
+	default:
+		return true;
+	}
+}
+
+/* Returns the number of rules that fired. A dry run skips the publish.
+ * Called with rules_mutex held, or on a private table.
+ */
+static int rules_eval(const struct rule_table *t, uint8_t button,
+		      uint8_t event, uint32_t press_count, bool dry_run)
+{
+	const size_t group = rule_group(button, event);
+	int fired = 0;
+	int ret;
+
+	for (size_t i = t->first[group]; i < t->first[group + 1]; i++) {
+		const struct rule *rule = &t->rules[i];
+
+		if (!rule_cond_met(rule, press_count)) {
+			continue;
+		}
+
+		fired++;
+		if (dry_run) {
+			continue;
+		}
+
+		/* LED_CMD_CHAN listeners run here, so a later rule in the
+		 * group already sees the LED state this one produced
+		 */
+		const struct led_msg msg = {
+			.type = rule->action,
+			.led_number = rule->led,
+		};
+
+		ret = zbus_stats_pub(&LED_CMD_CHAN, &msg, K_MSEC(10));
+		if (ret < 0) {
+			stats.failed++;
+			APP_LOG_WRN_RL("Rule %zu: LED command failed: %d", i,
+				       ret);
+		}
+	}
+
+	return fired;
+}
+
+/* ============================================================================
+ * ZBUS LISTENERS
+ * ============================================================================
+ */
+
+static void button_listener(const struct zbus_channel *chan)
+{
+	const struct button_msg *msg = zbus_chan_const_msg(chan);
+	const uint8_t event = msg->type == BUTTON_PRESSED ? RULE_EVENT_PRESS
+							  : RULE_EVENT_RELEASE;
+	uint32_t start;
+	uint32_t cycles;
+	int fired;
+
+	if (msg->button_number >= APP_NUM_BUTTONS) {
+		return;
+	}
+
+	k_mutex_lock(&rules_mutex, K_FOREVER);
+
+	start = k_cycle_get_32();
+	fired = rules_eval(&table, msg->button_number, event, msg->press_count,
+			   false);
+	cycles = k_cycle_get_32() - start;
+
+	stats.evals++;
+	stats.fired += fired;
+	stats.total_cycles += cycles;
+	stats.max_cycles = MAX(stats.max_cycles, cycles);
+
+	k_mutex_unlock(&rules_mutex);
+}
+
+ZBUS_STATS_LISTENER_DEFINE(rules_button_listener, button_listener);
+ZBUS_CHAN_ADD_OBS(BUTTON_CHAN, rules_button_listener, 0);
+
+static void led_state_listener(const struct zbus_channel *chan)
+{
+	const struct led_state_msg *msg = zbus_chan_const_msg(chan);
+
+	if (msg->led_number >= APP_NUM_LEDS) {
+		return;
+	}
+
+	if (msg->is_on) {
+		atomic_set_bit(&led_mask, msg->led_number);
+	} else {
+		atomic_clear_bit(&led_mask, msg->led_number);
+	}
+}
+
+ZBUS_STATS_LISTENER_DEFINE(rules_led_listener, led_state_listener);
+ZBUS_CHAN_ADD_OBS(LED_STATE_CHAN, rules_led_listener, 0);
+
+/* ============================================================================
+ * SETTINGS
+ * ============================================================================
+ */
+
+#if defined(CONFIG_APP_RULES_PERSIST)
+/* Flash writes stay off the HTTP server thread */
+static void save_fn(struct k_work *work)
+{
+	static struct rule copy[MAX_RULES];
+	size_t count;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&rules_mutex, K_FOREVER);
+	memcpy(copy, config, sizeof(copy));
+	count = config_count;
+	k_mutex_unlock(&rules_mutex);
+
+	if (count == 0) {
+		ret = settings_delete("rules/table");
+	} else {
+		ret = settings_save_one("rules/table", copy,
+					count * sizeof(copy[0]));
+	}
+
+	if (ret) {
+		LOG_WRN("Failed to save rules: %d", ret);
+	}
+}
+
+static K_WORK_DEFINE(save_work, save_fn);
+
+static int rules_settings_set(const char *key, size_t len,
+			      settings_read_cb read_cb, void *cb_arg)
+{
+	static struct rule stored[MAX_RULES];
+	const char *next;
+	ssize_t ret;
+	size_t count;
+
+	if (!settings_name_steq(key, "table", &next) || next) {
+		return -ENOENT;
+	}
+
+	/* A table from a build with a larger limit is cut short */
+	ret = read_cb(cb_arg, stored, MIN(len, sizeof(stored)));
+	if (ret < 0) {
+		return (int)ret;
+	}
+
+	/* Rules for buttons or LEDs this board lacks are dropped */
+	count = 0;
+	for (size_t i = 0; i < ret / sizeof(stored[0]); i++) {
+		if (rule_valid(&stored[i])) {
+			config[count++] = stored[i];
+		}
+	}
+	config_count = count;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(rules, "rules", NULL, rules_settings_set, NULL,
+			       NULL);
+#endif /* CONFIG_APP_RULES_PERSIST */
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+struct rule_json {
+	int32_t button;
+	char event[8];
+	char cond[8];
+	int32_t arg;
+	int32_t led;
+	char action[8];
+};
+
+struct rules_doc {
+	struct rule_json rules[MAX_RULES];
+	size_t rules_len;
+};
+
+static const struct json_obj_descr rule_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct rule_json, button, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct rule_json, event, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct rule_json, cond, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct rule_json, arg, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct rule_json, led, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct rule_json, action, JSON_TOK_STRING_BUF),
+};
+
+static const struct json_obj_descr rules_doc_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct rules_doc, rules, MAX_RULES, rules_len,
+				 rule_descr, ARRAY_SIZE(rule_descr)),
+};
+
+static int name_find(const char *const *names, size_t count, const char *name)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (names[i] && strcmp(names[i], name) == 0) {
+			return i;
+		}
+	}
+
+	return -EINVAL;
+}
+
+static int rule_from_json(const struct rule_json *in, struct rule *out)
+{
+	const int event =
+		name_find(event_names, ARRAY_SIZE(event_names), in->event);
+	const int cond = in->cond[0] == '\0'
+				 ? RULE_COND_ALWAYS
+				 : name_find(cond_names, ARRAY_SIZE(cond_names),
+					     in->cond);
+	const int action =
+		name_find(action_names, ARRAY_SIZE(action_names), in->action);
+
+	if (event < 0 || cond < 0 || action < 0 || in->button < 0 ||
+	    in->button > UINT8_MAX || in->led < 0 || in->led > UINT8_MAX ||
+	    in->arg < 0 || in->arg > UINT8_MAX) {
+		return -EINVAL;
+	}
+
+	*out = (struct rule){
+		.button = in->button,
+		.event = event,
+		.cond = cond,
+		.arg = cond == RULE_COND_ALWAYS ? 0 : in->arg,
+		.led = in->led,
+		.action = action,
+	};
+
+	return rule_valid(out) ? 0 : -EINVAL;
+}
+
+int rules_set_json(char *json, size_t len)
+{
+	/* Only called from the HTTP server thread */
+	static struct rules_doc doc;
+	static struct rule parsed[MAX_RULES];
+	int ret;
+
+	if (!json) {
+		return -EINVAL;
+	}
+
+	memset(&doc, 0, sizeof(doc));
+	ret = json_obj_parse(json, len, rules_doc_descr,
+			     ARRAY_SIZE(rules_doc_descr), &doc);
+	if (ret < 0 || !(ret & BIT(0))) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < doc.rules_len; i++) {
+		if (rule_from_json(&doc.rules[i], &parsed[i]) < 0) {
+			LOG_WRN("Rule %zu rejected", i);
+			return -EINVAL;
+		}
+	}
+
+	k_mutex_lock(&rules_mutex, K_FOREVER);
+	memcpy(config, parsed, doc.rules_len * sizeof(parsed[0]));
+	config_count = doc.rules_len;
+	rules_compile(&table, config, config_count);
+	k_mutex_unlock(&rules_mutex);
+
+	LOG_INF("%zu rules set", doc.rules_len);
+
+#if defined(CONFIG_APP_RULES_PERSIST)
+	k_work_submit(&save_work);
+#endif
+
+	return 0;
+}
+
+static int format_item(char *buf, size_t buf_len, uint32_t item)
+{
+	const struct rule *rule;
+
+	if (item == 0U) {
+		const struct rules_stats s = stats;
+
+		return snprintf(
+			buf, buf_len,
+			"{\"max\":%u,\"evals\":%u,\"fired\":%u,\"failed\":%u,"
+			"\"avg_ns\":%u,\"max_ns\":%u,\"rules\":[",
+			MAX_RULES, s.evals, s.fired, s.failed,
+			s.evals ? (uint32_t)k_cyc_to_ns_floor64(s.total_cycles /
+								s.evals)
+				: 0U,
+			(uint32_t)k_cyc_to_ns_floor64(s.max_cycles));
+	}
+
+	if (item > config_count) {
+		return snprintf(buf, buf_len, "]}");
+	}
+
+	rule = &config[item - 1U];
+
+	return snprintf(buf, buf_len,
+			"%s{\"button\":%u,\"event\":\"%s\",\"cond\":\"%s\","
+			"\"arg\":%u,\"led\":%u,\"action\":\"%s\"}",
+			item == 1U ? "" : ",", rule->button,
+			event_names[rule->event], cond_names[rule->cond],
+			rule->arg, rule->led, action_names[rule->action]);
+}
+
+int rules_json_chunk(char *buf, size_t buf_len, uint32_t *cursor, bool *done)
+{
+	int offset = 0;
+	int written;
+
+	if (!buf || buf_len == 0 || !cursor || !done) {
+		return -EINVAL;
+	}
+
+	*done = false;
+
+	k_mutex_lock(&rules_mutex, K_FOREVER);
+
+	/* Items: header, one per rule, footer */
+	while (*cursor <= config_count + 1U) {
+		written = format_item(buf + offset, buf_len - offset, *cursor);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			k_mutex_unlock(&rules_mutex);
+			if (offset == 0) {
+				return -ENOMEM;
+			}
+			/* Item goes into the next chunk */
+			buf[offset] = '\0';
+			return offset;
+		}
+
+		offset += written;
+		(*cursor)++;
+	}
+
+	k_mutex_unlock(&rules_mutex);
+
+	*done = true;
+	return offset;
+}
+
+/* ============================================================================
+ * BENCHMARK
+ * ============================================================================
+ */
+
+#if defined(CONFIG_APP_RULES_BENCH)
+/* Table sizes 1, 2, 4, ... and MAX_RULES */
+#define BENCH_POINTS (LOG2CEIL(MAX_RULES) + 1)
+
+enum bench_state {
+	BENCH_IDLE,
+	BENCH_RUNNING,
+	BENCH_DONE,
+};
+
+struct bench_point {
+	uint32_t rules;
+	uint32_t cycles;
+};
+
+static struct bench_point bench_points[BENCH_POINTS];
+static atomic_t bench_state;
+
+/* Every rule belongs to the evaluated group and fires, the worst case
+ * for a table of that size. Runs on the event loop like real events.
+ */
+static void bench_fn(struct k_work *work)
+{
+	static struct rule_table bench_table;
+	static struct rule rules[MAX_RULES];
+	volatile int sink = 0;
+	uint32_t start;
+
+	ARG_UNUSED(work);
+
+	for (size_t p = 0; p < BENCH_POINTS; p++) {
+		const size_t count = MIN(BIT(p), MAX_RULES);
+
+		for (size_t i = 0; i < count; i++) {
+			rules[i] = (struct rule){
+				.button = 0,
+				.event = RULE_EVENT_PRESS,
+				.cond = RULE_COND_EVERY,
+				.arg = 1,
+				.led = i % APP_NUM_LEDS,
+				.action = LED_COMMAND_TOGGLE,
+			};
+		}
+		rules_compile(&bench_table, rules, count);
+
+		start = k_cycle_get_32();
+		for (uint32_t n = 0; n < CONFIG_APP_RULES_BENCH_ITERATIONS;
+		     n++) {
+			sink += rules_eval(&bench_table, 0, RULE_EVENT_PRESS, n,
+					   true);
+		}
+		bench_points[p].cycles = k_cycle_get_32() - start;
+		bench_points[p].rules = count;
+	}
+
+	ARG_UNUSED(sink);
+	atomic_set(&bench_state, BENCH_DONE);
+}
+
+static K_WORK_DEFINE(bench_work, bench_fn);
+
+int rules_bench_start(void)
+{
+	if (atomic_set(&bench_state, BENCH_RUNNING) == BENCH_RUNNING) {
+		return -EBUSY;
+	}
+
+	event_loop_submit(&bench_work);
+
+	return 0;
+}
+
+int rules_bench_json(char *buf, size_t buf_len)
+{
+	const atomic_val_t state = atomic_get(&bench_state);
+	int offset;
+	int written;
+
+	if (state != BENCH_DONE) {
+		written = snprintf(buf, buf_len, "{\"state\":\"%s\"}",
+				   state == BENCH_RUNNING ? "running" : "idle");
+		return (written < 0 || written >= buf_len) ? -ENOMEM : written;
+	}
+
+	written = snprintf(buf, buf_len,
+			   "{\"state\":\"done\",\"iterations\":%u,"
+			   "\"cycles_per_sec\":%u,\"points\":[",
+			   CONFIG_APP_RULES_BENCH_ITERATIONS,
+			   sys_clock_hw_cycles_per_sec());
+	if (written < 0 || written >= buf_len) {
+		return -ENOMEM;
+	}
+	offset = written;
+
+	for (size_t p = 0; p < BENCH_POINTS; p++) {
+		const struct bench_point *point = &bench_points[p];
+		const uint32_t ns =
+			(uint32_t)(k_cyc_to_ns_floor64(point->cycles) /
+				   CONFIG_APP_RULES_BENCH_ITERATIONS);
+
+		written = snprintf(buf + offset, buf_len - offset,
+				   "%s{\"rules\":%u,\"cycles\":%u,\"ns\":%u,"
+				   "\"ns_per_rule\":%u}",
+				   p == 0 ? "" : ",", point->rules,
+				   point->cycles /
+					   CONFIG_APP_RULES_BENCH_ITERATIONS,
+				   ns, ns / point->rules);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			return -ENOMEM;
+		}
+		offset += written;
+	}
+
+	written = snprintf(buf + offset, buf_len - offset, "]}");
+	if (written < 0 || written >= (int)(buf_len - offset)) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+#endif /* CONFIG_APP_RULES_BENCH */
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int rules_init(void)
+{
+#if defined(CONFIG_APP_RULES_PERSIST)
+	int ret;
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Settings init failed: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree("rules");
+	if (ret) {
+		LOG_WRN("Failed to load rules: %d", ret);
+	}
+#endif
+
+	k_mutex_lock(&rules_mutex, K_FOREVER);
+	rules_compile(&table, config, config_count);
+	k_mutex_unlock(&rules_mutex);
+
+	LOG_INF("%zu rules loaded", config_count);
+
+	return 0;
+}
+
+SYS_INIT(rules_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
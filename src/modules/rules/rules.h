@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file rules.h
+ * @brief Button to LED rules engine
+ *
+ * A rule reads "on <event> of <button>, if <condition>, switch <led>".
+ * Rules are grouped by button and event when the table is set, so a
+ * button event only visits the rules written for it.
+ */
+
+#ifndef RULES_H
+#define RULES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Replace the rule table from a JSON document
+ *
+ * The document has the form
+ * {"rules":[{"button":0,"event":"press","cond":"always","arg":0,
+ * "led":1,"action":"toggle"}]}. "cond" is one of "always", "led_on",
+ * "led_off" (arg is the LED) or "every" (fires on every arg-th press).
+ * The buffer is modified by the parser.
+ *
+ * @param json JSON document
+ * @param len Document length
+ * @return 0 on success, -EINVAL for a malformed or invalid table
+ */
+int rules_set_json(char *json, size_t len);
+
+/**
+ * @brief Write the next fragment of the rule table and statistics as JSON
+ *
+ * @param buf Buffer for the fragment
+ * @param buf_len Buffer length
+ * @param cursor Position in the document, 0 for the first call
+ * @param done Set when the document is complete
+ * @return Number of bytes written, or negative error code
+ */
+int rules_json_chunk(char *buf, size_t buf_len, uint32_t *cursor, bool *done);
+
+#if defined(CONFIG_APP_RULES_BENCH)
+/**
+ * @brief Start the evaluation cost benchmark on the event loop
+ * @return 0 on success, -EBUSY if a run is in progress
+ */
+int rules_bench_start(void);
+
+/**
+ * @brief Serialize the benchmark state and results as JSON
+ * @param buf Buffer to store the JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int rules_bench_json(char *buf, size_t buf_len);
+#endif /* CONFIG_APP_RULES_BENCH */
+
+#endif /* RULES_H */
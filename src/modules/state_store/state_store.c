@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "state_store.h"
+#include "../messages.h"
+#include "../zbus_stats/zbus_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_state_store, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+
+BUILD_ASSERT(APP_NUM_LEDS <= 32, "LED states are stored as a bitmask");
+
+/* Stored values, one settings key each so a toggle does not rewrite
+ * the counters
+ */
+struct stored_state {
+	uint32_t led_mask;
+	uint32_t presses[APP_NUM_BUTTONS];
+};
+
+/* Live state, updated from zbus listeners */
+static struct stored_state live;
+/* Last state written to (or read from) flash */
+static struct stored_state persisted;
+static bool leds_restored;
+static bool presses_restored;
+/* Uptime of the first change not yet flushed, 0 when clean */
+static int64_t first_dirty;
+/* Delay before the next attempt after a failed flush, 0 when not retrying */
+static uint32_t retry_ms;
+static struct k_spinlock state_lock;
+
+static atomic_t loaded;
+
+/* ============================================================================
+ * WRITE-BEHIND
+ * ============================================================================
+ */
+
+static void flush_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_fn);
+
+static void flush_fn(struct k_work *work)
+{
+	struct stored_state snapshot;
+	k_spinlock_key_t key;
+	int64_t dirty_since;
+	uint32_t retry = 0;
+	bool failed = false;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&state_lock);
+	snapshot = live;
+	dirty_since = first_dirty;
+	first_dirty = 0;
+	k_spin_unlock(&state_lock, key);
+
+	/* Only keys whose value changed cost a flash write */
+	if (snapshot.led_mask != persisted.led_mask) {
+		ret = settings_save_one("app/leds", &snapshot.led_mask,
+					sizeof(snapshot.led_mask));
+		if (ret) {
+			LOG_WRN("Failed to save LED state: %d", ret);
+			failed = true;
+		} else {
+			persisted.led_mask = snapshot.led_mask;
+		}
+	}
+
+	if (memcmp(snapshot.presses, persisted.presses,
+		   sizeof(snapshot.presses)) != 0) {
+		ret = settings_save_one("app/presses", snapshot.presses,
+					sizeof(snapshot.presses));
+		if (ret) {
+			LOG_WRN("Failed to save press counters: %d", ret);
+			failed = true;
+		} else {
+			memcpy(persisted.presses, snapshot.presses,
+			       sizeof(persisted.presses));
+		}
+	}
+
+	key = k_spin_lock(&state_lock);
+	if (failed) {
+		/* Still dirty since the original change, retry with backoff */
+		if (dirty_since != 0) {
+			first_dirty = dirty_since;
+		}
+		retry_ms = (retry_ms == 0)
+				   ? CONFIG_APP_STATE_STORE_RETRY_MS
+				   : MIN(retry_ms * 2U,
+					 MAX(CONFIG_APP_STATE_STORE_RETRY_MS,
+					     CONFIG_APP_STATE_STORE_MAX_DELAY_MS));
+		retry = retry_ms;
+		k_work_reschedule(&flush_work, K_MSEC(retry));
+	} else {
+		retry_ms = 0;
+	}
+	k_spin_unlock(&state_lock, key);
+
+	if (failed) {
+		LOG_WRN("State flush failed, retrying in %u ms", retry);
+	} else {
+		LOG_DBG("State flushed");
+	}
+}
+
+/* Flush after IDLE_MS of quiet, but no later than MAX_DELAY_MS after the
+ * first change. While a failed flush waits for its retry, the retry picks
+ * up the change. Called with state_lock held.
+ */
+static void flush_schedule(void)
+{
+	int64_t now = k_uptime_get();
+	int64_t delay;
+
+	if (first_dirty == 0) {
+		first_dirty = now;
+	}
+
+	if (retry_ms != 0) {
+		return;
+	}
+
+	delay = MIN((int64_t)CONFIG_APP_STATE_STORE_IDLE_MS,
+		    first_dirty + CONFIG_APP_STATE_STORE_MAX_DELAY_MS - now);
+
+	k_work_reschedule(&flush_work, K_MSEC(MAX(delay, 0)));
+}
+
+/* ============================================================================
+ * ZBUS LISTENERS
+ * ============================================================================
+ */
+
+#if defined(CONFIG_LED_MODULE)
+static void led_state_listener(const struct zbus_channel *chan)
+{
+	const struct led_state_msg *msg = zbus_chan_const_msg(chan);
+	k_spinlock_key_t key;
+	uint32_t mask;
+
+	if (msg->led_number >= APP_NUM_LEDS) {
+		return;
+	}
+
+	key = k_spin_lock(&state_lock);
+	mask = live.led_mask;
+	WRITE_BIT(live.led_mask, msg->led_number, msg->is_on);
+	if (live.led_mask != mask) {
+		flush_schedule();
+	}
+	k_spin_unlock(&state_lock, key);
+}
+
+ZBUS_STATS_LISTENER_DEFINE(state_store_led_listener, led_state_listener);
+
+extern const struct zbus_channel LED_STATE_CHAN;
+ZBUS_CHAN_ADD_OBS(LED_STATE_CHAN, state_store_led_listener, 0);
+#endif /* CONFIG_LED_MODULE */
+
+#if defined(CONFIG_BUTTON_MODULE)
+static void button_listener(const struct zbus_channel *chan)
+{
+	const struct button_msg *msg = zbus_chan_const_msg(chan);
+	k_spinlock_key_t key;
+
+	if (msg->type != BUTTON_PRESSED ||
+	    msg->button_number >= APP_NUM_BUTTONS) {
+		return;
+	}
+
+	key = k_spin_lock(&state_lock);
+	live.presses[msg->button_number] = msg->press_count;
+	flush_schedule();
+	k_spin_unlock(&state_lock, key);
+}
+
+ZBUS_STATS_LISTENER_DEFINE(state_store_button_listener, button_listener);
+
+extern const struct zbus_channel BUTTON_CHAN;
+ZBUS_CHAN_ADD_OBS(BUTTON_CHAN, state_store_button_listener, 0);
+#endif /* CONFIG_BUTTON_MODULE */
+
+/* ============================================================================
+ * SETTINGS
+ * ============================================================================
+ */
+
+static int state_store_set(const char *key, size_t len,
+			   settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	ssize_t ret;
+
+	if (settings_name_steq(key, "leds", &next) && !next) {
+		if (len != sizeof(persisted.led_mask)) {
+			return -EINVAL;
+		}
+
+		ret = read_cb(cb_arg, &persisted.led_mask, len);
+		if (ret < 0) {
+			return (int)ret;
+		}
+
+		live.led_mask = persisted.led_mask;
+		leds_restored = true;
+		return 0;
+	}
+
+	if (settings_name_steq(key, "presses", &next) && !next) {
+		/* Boards differ in button count, keep the common prefix, but
+		 * a partial counter means the record is damaged
+		 */
+		if (len == 0 || len % sizeof(persisted.presses[0]) != 0) {
+			return -EINVAL;
+		}
+
+		ret = read_cb(cb_arg, persisted.presses,
+			      MIN(len, sizeof(persisted.presses)));
+		if (ret < 0) {
+			return (int)ret;
+		}
+
+		memcpy(live.presses, persisted.presses, sizeof(live.presses));
+		presses_restored = true;
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(state_store, "app", NULL, state_store_set, NULL,
+			       NULL);
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+int state_store_load(void)
+{
+	int ret;
+
+	if (atomic_set(&loaded, 1)) {
+		return 0;
+	}
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Settings init failed: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree("app");
+	if (ret) {
+		LOG_WRN("Failed to load stored state: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("Stored state: LEDs %s, counters %s",
+		leds_restored ? "restored" : "default",
+		presses_restored ? "restored" : "default");
+
+	return 0;
+}
+
+int state_store_led_get(uint8_t led_number, bool *is_on)
+{
+	if (led_number >= APP_NUM_LEDS || !is_on) {
+		return -EINVAL;
+	}
+
+	if (!leds_restored) {
+		return -ENOENT;
+	}
+
+	*is_on = (persisted.led_mask & BIT(led_number)) != 0;
+	return 0;
+}
+
+int state_store_press_count_get(uint8_t button_number, uint32_t *press_count)
+{
+	if (button_number >= APP_NUM_BUTTONS || !press_count) {
+		return -EINVAL;
+	}
+
+	if (!presses_restored) {
+		return -ENOENT;
+	}
+
+	*press_count = persisted.presses[button_number];
+	return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file state_store.h
+ * @brief Persistent LED state and button counters
+ */
+
+#ifndef STATE_STORE_H
+#define STATE_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+
+#if defined(CONFIG_APP_STATE_STORE)
+/**
+ * @brief Load persisted state
+ *
+ * Safe to call from several module initializers, only the first call
+ * reads the settings backend.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int state_store_load(void);
+
+/**
+ * @brief Get the persisted state of an LED
+ * @param led_number LED index
+ * @param is_on Restored state
+ * @return 0 on success, -ENOENT if nothing was stored
+ */
+int state_store_led_get(uint8_t led_number, bool *is_on);
+
+/**
+ * @brief Get the persisted press counter of a button
+ * @param button_number Button index
+ * @param press_count Restored counter
+ * @return 0 on success, -ENOENT if nothing was stored
+ */
+int state_store_press_count_get(uint8_t button_number, uint32_t *press_count);
+#else
+static inline int state_store_load(void)
+{
+	return -ENOTSUP;
+}
+
+static inline int state_store_led_get(uint8_t led_number, bool *is_on)
+{
+	ARG_UNUSED(led_number);
+	ARG_UNUSED(is_on);
+	return -ENOTSUP;
+}
+
+static inline int state_store_press_count_get(uint8_t button_number,
+					      uint32_t *press_count)
+{
+	ARG_UNUSED(button_number);
+	ARG_UNUSED(press_count);
+	return -ENOTSUP;
+}
+#endif /* CONFIG_APP_STATE_STORE */
+
+#endif /* STATE_STORE_H */
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "net_telemetry.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_net_telemetry, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <errno.h>
+#include <stdio.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/util.h>
+
+/* ============================================================================
+ * POOL USAGE
+ * ============================================================================
+ */
+
+static const char *const pool_names[NET_TELEMETRY_POOL_COUNT] = {
+	[NET_TELEMETRY_RX_PKTS] = "rx_pkts",
+	[NET_TELEMETRY_TX_PKTS] = "tx_pkts",
+	[NET_TELEMETRY_RX_BUFS] = "rx_bufs",
+	[NET_TELEMETRY_TX_BUFS] = "tx_bufs",
+};
+
+static struct k_mem_slab *pkt_slabs[2];
+static struct net_buf_pool *buf_pools[2];
+
+static uint32_t pool_count(enum net_telemetry_pool pool)
+{
+	if (pool <= NET_TELEMETRY_TX_PKTS) {
+		return pkt_slabs[pool]->info.num_blocks;
+	}
+
+	return buf_pools[pool - NET_TELEMETRY_RX_BUFS]->buf_count;
+}
+
+static uint32_t pool_free(enum net_telemetry_pool pool)
+{
+	if (pool <= NET_TELEMETRY_TX_PKTS) {
+		return k_mem_slab_num_free_get(pkt_slabs[pool]);
+	}
+
+	return atomic_get(&buf_pools[pool - NET_TELEMETRY_RX_BUFS]->avail_count);
+}
+
+/* The allocators record the peak themselves on every allocation, so no
+ * shortage is missed and nothing runs while the pools are idle
+ */
+static uint32_t pool_max_used(enum net_telemetry_pool pool)
+{
+	if (pool <= NET_TELEMETRY_TX_PKTS) {
+		return k_mem_slab_max_used_get(pkt_slabs[pool]);
+	}
+
+	return buf_pools[pool - NET_TELEMETRY_RX_BUFS]->max_used;
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+int net_telemetry_usage_get(enum net_telemetry_pool pool,
+			    struct net_telemetry_usage *usage)
+{
+	if (pool >= NET_TELEMETRY_POOL_COUNT || !usage) {
+		return -EINVAL;
+	}
+
+	usage->count = pool_count(pool);
+	usage->free = pool_free(pool);
+	usage->min_free = usage->count - MIN(pool_max_used(pool), usage->count);
+
+	return 0;
+}
+
+void net_telemetry_reset(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(buf_pools); i++) {
+		struct net_buf_pool *bufs = buf_pools[i];
+
+		(void)k_mem_slab_runtime_stats_reset_max(pkt_slabs[i]);
+
+		/* Not under the pool lock: an allocation racing the reset can
+		 * only leave the peak one buffer low
+		 */
+		bufs->max_used = bufs->buf_count - atomic_get(&bufs->avail_count);
+	}
+}
+
+struct context_count {
+	uint32_t used;
+	uint32_t tcp_listen;
+	uint32_t tcp_conn;
+	uint32_t udp;
+};
+
+static void context_count_cb(struct net_context *context, void *user_data)
+{
+	struct context_count *count = user_data;
+
+	count->used++;
+
+	if (net_context_get_proto(context) == IPPROTO_TCP) {
+		if (net_context_get_state(context) == NET_CONTEXT_LISTENING) {
+			count->tcp_listen++;
+		} else {
+			count->tcp_conn++;
+		}
+	} else if (net_context_get_proto(context) == IPPROTO_UDP) {
+		count->udp++;
+	}
+}
+
+int net_telemetry_json(char *buf, size_t buf_len)
+{
+	struct net_stats stats = {0};
+	struct context_count contexts = {0};
+	struct net_telemetry_usage usage;
+	int offset = 0;
+	int written;
+
+	if (!buf || buf_len == 0) {
+		return -EINVAL;
+	}
+
+	written = snprintf(buf, buf_len, "{\"pools\":{");
+	if (written < 0 || written >= (int)buf_len) {
+		return -ENOMEM;
+	}
+	offset = written;
+
+	for (int i = 0; i < NET_TELEMETRY_POOL_COUNT; i++) {
+		net_telemetry_usage_get(i, &usage);
+
+		written = snprintf(buf + offset, buf_len - offset,
+				   "%s\"%s\":{\"count\":%u,\"free\":%u,"
+				   "\"min_free\":%u}",
+				   i == 0 ? "" : ",", pool_names[i],
+				   usage.count, usage.free, usage.min_free);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			return -ENOMEM;
+		}
+		offset += written;
+	}
+
+	/* Totals over all interfaces */
+	if (net_mgmt(NET_REQUEST_STATS_GET_ALL, NULL, &stats,
+		     sizeof(stats)) < 0) {
+		LOG_DBG("Network statistics unavailable");
+	}
+
+	net_context_foreach(context_count_cb, &contexts);
+
+	written = snprintf(
+		buf + offset, buf_len - offset,
+		"},\"tcp\":{\"sent\":%u,\"recv\":%u,\"rexmit\":%u,"
+		"\"resent_bytes\":%u,\"drop\":%u,\"seg_drop\":%u,"
+		"\"conn_drop\":%u,\"conn_rst\":%u},"
+		"\"drops\":{\"ipv4\":%u,\"udp\":%u,\"processing\":%u},"
+		"\"contexts\":{\"max\":%u,\"used\":%u,\"tcp_listen\":%u,"
+		"\"tcp_conn\":%u,\"udp\":%u}}",
+		stats.tcp.sent, stats.tcp.recv, stats.tcp.rexmit,
+		stats.tcp.resent, stats.tcp.drop, stats.tcp.seg_drop,
+		stats.tcp.conndrop, stats.tcp.connrst, stats.ipv4.drop,
+		stats.udp.drop, stats.processing_error, CONFIG_NET_MAX_CONTEXTS,
+		contexts.used, contexts.tcp_listen, contexts.tcp_conn,
+		contexts.udp);
+	if (written < 0 || written >= (int)(buf_len - offset)) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int net_telemetry_init(void)
+{
+	net_pkt_get_info(&pkt_slabs[0], &pkt_slabs[1], &buf_pools[0],
+			 &buf_pools[1]);
+
+	return 0;
+}
+
+SYS_INIT(net_telemetry_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file net_telemetry.h
+ * @brief Network packet and buffer pool utilization telemetry
+ */
+
+#ifndef NET_TELEMETRY_H
+#define NET_TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Pools sized by NET_PKT_RX/TX_COUNT and NET_BUF_RX/TX_COUNT */
+enum net_telemetry_pool {
+	NET_TELEMETRY_RX_PKTS,
+	NET_TELEMETRY_TX_PKTS,
+	NET_TELEMETRY_RX_BUFS,
+	NET_TELEMETRY_TX_BUFS,
+	NET_TELEMETRY_POOL_COUNT,
+};
+
+/** Utilization of one pool */
+struct net_telemetry_usage {
+	uint32_t count;
+	uint32_t free;
+	/* Lowest free count since boot or the last reset, from the peak
+	 * usage recorded by the pool on allocation
+	 */
+	uint32_t min_free;
+};
+
+/**
+ * @brief Get the utilization of a pool
+ * @param pool Pool to query
+ * @param usage Filled with the current and lowest free counts
+ * @return 0 on success, -EINVAL for an invalid argument
+ */
+int net_telemetry_usage_get(enum net_telemetry_pool pool,
+			    struct net_telemetry_usage *usage);
+
+/**
+ * @brief Restart the minimum free counts from the current levels
+ */
+void net_telemetry_reset(void);
+
+/**
+ * @brief Serialize pool utilization, TCP and drop counters as JSON
+ * @param buf Buffer to store the JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int net_telemetry_json(char *buf, size_t buf_len);
+
+#endif /* NET_TELEMETRY_H */
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "thread_telemetry.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_thread_telemetry, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#define MAX_THREADS CONFIG_APP_THREAD_TELEMETRY_MAX_THREADS
+#define NAME_LEN    CONFIG_THREAD_MAX_NAME_LEN
+
+/* ============================================================================
+ * SNAPSHOT TABLE
+ * ============================================================================
+ */
+
+struct thread_entry {
+	const struct k_thread *thread;
+	char name[NAME_LEN];
+	int prio;
+	/* Raw counters from the previous sample */
+	uint64_t last_cycles;
+	uint32_t last_windows;
+	/* Values computed over the last window */
+	uint64_t window_cycles;
+	uint32_t switches;
+	uint32_t cpu_permille;
+	size_t stack_size;
+	size_t stack_unused;
+	bool seen;
+};
+
+static struct thread_entry threads[MAX_THREADS];
+static uint32_t window_ms;
+static uint32_t dropped_threads;
+static K_MUTEX_DEFINE(telemetry_mutex);
+
+static struct thread_entry *entry_get(const struct k_thread *thread)
+{
+	struct thread_entry *free_slot = NULL;
+
+	for (int i = 0; i < MAX_THREADS; i++) {
+		if (threads[i].thread == thread) {
+			return &threads[i];
+		}
+		if (!free_slot && !threads[i].thread) {
+			free_slot = &threads[i];
+		}
+	}
+
+	if (free_slot) {
+		memset(free_slot, 0, sizeof(*free_slot));
+		free_slot->thread = thread;
+	}
+
+	return free_slot;
+}
+
+/* ============================================================================
+ * SAMPLING
+ * ============================================================================
+ */
+
+static void sample_thread(const struct k_thread *thread, void *user_data)
+{
+	uint64_t *total_cycles = user_data;
+	k_tid_t tid = (k_tid_t)thread;
+	struct thread_entry *entry = entry_get(thread);
+	k_thread_runtime_stats_t stats;
+	const char *name;
+	size_t unused;
+
+	if (!entry) {
+		dropped_threads++;
+		return;
+	}
+
+	/* A counter that went backwards belongs to a new thread created in
+	 * the same k_thread struct, so all of it is from this window
+	 */
+	if (k_thread_runtime_stats_get(tid, &stats) == 0) {
+		if (stats.execution_cycles < entry->last_cycles) {
+			entry->last_cycles = 0;
+		}
+		entry->window_cycles = stats.execution_cycles -
+				       entry->last_cycles;
+		entry->last_cycles = stats.execution_cycles;
+		*total_cycles += entry->window_cycles;
+	}
+
+	/* Every scheduling window is one switch into the thread */
+	if (thread->base.usage.num_windows < entry->last_windows) {
+		entry->last_windows = 0;
+	}
+	entry->switches = thread->base.usage.num_windows - entry->last_windows;
+	entry->last_windows = thread->base.usage.num_windows;
+
+	name = k_thread_name_get(tid);
+	if (name && name[0] != '\0') {
+		strncpy(entry->name, name, sizeof(entry->name) - 1);
+	} else {
+		snprintf(entry->name, sizeof(entry->name), "%p", thread);
+	}
+
+	entry->prio = k_thread_priority_get(tid);
+	entry->stack_size = thread->stack_info.size;
+	if (k_thread_stack_space_get(thread, &unused) == 0) {
+		entry->stack_unused = unused;
+	}
+
+	entry->seen = true;
+}
+
+static void telemetry_sample_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(telemetry_work, telemetry_sample_fn);
+
+static void telemetry_sample_fn(struct k_work *work)
+{
+	static int64_t last_sample;
+	uint64_t total_cycles = 0;
+	int64_t now = k_uptime_get();
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+	for (int i = 0; i < MAX_THREADS; i++) {
+		threads[i].seen = false;
+	}
+
+	dropped_threads = 0;
+	k_thread_foreach_unlocked(sample_thread, &total_cycles);
+
+	for (int i = 0; i < MAX_THREADS; i++) {
+		struct thread_entry *entry = &threads[i];
+
+		if (!entry->thread) {
+			continue;
+		}
+
+		/* Thread exited since the previous sample */
+		if (!entry->seen) {
+			entry->thread = NULL;
+			continue;
+		}
+
+		entry->cpu_permille =
+			total_cycles ? (uint32_t)((entry->window_cycles * 1000U) /
+						  total_cycles)
+				     : 0U;
+	}
+
+	window_ms = last_sample ? (uint32_t)(now - last_sample) : 0U;
+	last_sample = now;
+
+	k_mutex_unlock(&telemetry_mutex);
+
+	k_work_reschedule(&telemetry_work,
+			  K_MSEC(CONFIG_APP_THREAD_TELEMETRY_INTERVAL_MS));
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+static int format_entry(char *buf, size_t buf_len,
+			const struct thread_entry *entry, bool first)
+{
+	return snprintf(buf, buf_len,
+			/* clang-format off */
+			"%s{\"name\":\"%s\",\"prio\":%d,\"cpu_pct\":%u.%u,"
+			"\"switches\":%u,\"stack_size\":%u,\"stack_used\":%u,"
+			"\"stack_unused\":%u}",
+			/* clang-format on */
+			first ? "" : ",", entry->name, entry->prio,
+			entry->cpu_permille / 10U, entry->cpu_permille % 10U,
+			entry->switches, (unsigned int)entry->stack_size,
+			(unsigned int)(entry->stack_size - entry->stack_unused),
+			(unsigned int)entry->stack_unused);
+}
+
+/* Set in the cursor once an entry has been written, so the separator does
+ * not depend on which slots are still in use when a later chunk is made
+ */
+#define CURSOR_EMITTED BIT(31)
+
+int thread_telemetry_json_chunk(char *buf, size_t buf_len, uint32_t *cursor,
+				bool *done)
+{
+	int offset = 0;
+	int written;
+
+	if (!buf || buf_len == 0 || !cursor || !done) {
+		return -EINVAL;
+	}
+
+	*done = false;
+
+	k_mutex_lock(&telemetry_mutex, K_FOREVER);
+
+	/* Cursor 0 is the header, 1..MAX_THREADS the table slots */
+	if (*cursor == 0U) {
+		written = snprintf(buf, buf_len,
+				   "{\"window_ms\":%u,\"dropped\":%u,"
+				   "\"threads\":[",
+				   window_ms, dropped_threads);
+		if (written < 0 || written >= (int)buf_len) {
+			k_mutex_unlock(&telemetry_mutex);
+			return -ENOMEM;
+		}
+		offset = written;
+		*cursor = 1U;
+	}
+
+	while ((*cursor & ~CURSOR_EMITTED) <= MAX_THREADS) {
+		const uint32_t slot = *cursor & ~CURSOR_EMITTED;
+		const struct thread_entry *entry = &threads[slot - 1U];
+
+		if (!entry->thread) {
+			(*cursor)++;
+			continue;
+		}
+
+		written = format_entry(buf + offset, buf_len - offset, entry,
+				       !(*cursor & CURSOR_EMITTED));
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			if (offset == 0) {
+				k_mutex_unlock(&telemetry_mutex);
+				return -ENOMEM;
+			}
+			/* Entry goes into the next chunk */
+			buf[offset] = '\0';
+			k_mutex_unlock(&telemetry_mutex);
+			return offset;
+		}
+
+		offset += written;
+		*cursor = (*cursor + 1U) | CURSOR_EMITTED;
+	}
+
+	k_mutex_unlock(&telemetry_mutex);
+
+	written = snprintf(buf + offset, buf_len - offset, "]}");
+	if (written < 0 || written >= (int)(buf_len - offset)) {
+		if (offset == 0) {
+			return -ENOMEM;
+		}
+		return offset;
+	}
+
+	*done = true;
+	return offset + written;
+}
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int thread_telemetry_init(void)
+{
+	LOG_INF("Thread telemetry sampling every %d ms",
+		CONFIG_APP_THREAD_TELEMETRY_INTERVAL_MS);
+
+	k_work_schedule(&telemetry_work,
+			K_MSEC(CONFIG_APP_THREAD_TELEMETRY_INTERVAL_MS));
+
+	return 0;
+}
+
+SYS_INIT(thread_telemetry_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
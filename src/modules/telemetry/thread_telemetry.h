@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file thread_telemetry.h
+ * @brief Per-thread CPU utilization and stack usage telemetry
+ */
+
+#ifndef THREAD_TELEMETRY_H
+#define THREAD_TELEMETRY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Serialize part of the latest thread snapshot as JSON
+ *
+ * The document is produced incrementally so it can be sent as HTTP chunks
+ * from a small buffer. Start with *cursor set to 0 and call repeatedly
+ * until *done is true.
+ *
+ * @param buf Buffer to store the JSON fragment
+ * @param buf_len Buffer length
+ * @param cursor Position in the document, advanced on return
+ * @param done Set to true once the closing bracket has been written
+ * @return Number of bytes written, or negative error code
+ */
+int thread_telemetry_json_chunk(char *buf, size_t buf_len, uint32_t *cursor,
+				bool *done);
+
+#endif /* THREAD_TELEMETRY_H */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "api_json.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/data/json.h>
+#include <zephyr/sys/util.h>
+
+/* ============================================================================
+ * SERIALIZERS
+ * ============================================================================
+ */
+
+int api_json_buttons(char *buf, size_t buf_len,
+		     const struct api_json_button *buttons, size_t count)
+{
+	int offset = 0;
+	int remaining = buf_len;
+	int written = snprintf(buf + offset, remaining, "{\"buttons\":[");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	for (size_t i = 0; i < count; i++) {
+		const bool is_last = (i == count - 1);
+		const char *button_name = app_button_label(buttons[i].number);
+
+		written = snprintf(
+			buf + offset, remaining,
+			/* clang-format off */
+			"{\"number\":%u,\"name\":\"%s\",\"pressed\":%s, \"count\":%u,\"bounces\":%u}%s",
+			/* clang-format on */
+			buttons[i].number, button_name ? button_name : "",
+			buttons[i].pressed ? "true" : "false",
+			buttons[i].count, buttons[i].bounces,
+			is_last ? "" : ",");
+		if (written < 0 || written >= remaining) {
+			return -ENOMEM;
+		}
+		offset += written;
+		remaining -= written;
+	}
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+int api_json_leds(char *buf, size_t buf_len, const bool *is_on, size_t count)
+{
+	int offset = 0;
+	int remaining = buf_len;
+	int written = snprintf(buf, remaining, "{\"leds\":[");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	for (size_t i = 0; i < count; i++) {
+		const bool is_last = (i == count - 1);
+		const char *led_name = app_led_label(i);
+
+		written = snprintf(
+			buf + offset, remaining,
+			"{\"number\":%d,\"name\":\"%s\",\"is_on\":%s}%s", (int)i,
+			led_name ? led_name : "", is_on[i] ? "true" : "false",
+			is_last ? "" : ",");
+		if (written < 0 || written >= remaining) {
+			return -ENOMEM;
+		}
+		offset += written;
+		remaining -= written;
+	}
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+/* ============================================================================
+ * PARSERS
+ * ============================================================================
+ */
+
+struct led_control_cmd {
+	uint8_t led;
+	char action[8]; /* "on", "off", "toggle" */
+};
+
+static const struct json_obj_descr led_control_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct led_control_cmd, led, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct led_control_cmd, action,
+			    JSON_TOK_STRING_BUF),
+};
+
+int api_json_led_cmd_parse(char *body, size_t len, uint8_t num_leds,
+			   struct led_msg *msg)
+{
+	struct led_control_cmd cmd;
+	int ret;
+
+	if (!body || len == 0 || !msg) {
+		return -EINVAL;
+	}
+
+	memset(&cmd, 0, sizeof(cmd));
+	ret = json_obj_parse(body, len, led_control_descr,
+			     ARRAY_SIZE(led_control_descr), &cmd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (cmd.led >= num_leds) {
+		return -ERANGE;
+	}
+
+	if (strcmp(cmd.action, "on") == 0) {
+		msg->type = LED_COMMAND_ON;
+	} else if (strcmp(cmd.action, "off") == 0) {
+		msg->type = LED_COMMAND_OFF;
+	} else if (strcmp(cmd.action, "toggle") == 0) {
+		msg->type = LED_COMMAND_TOGGLE;
+	} else {
+		return -ENOTSUP;
+	}
+
+	msg->led_number = cmd.led;
+
+	return 0;
+}
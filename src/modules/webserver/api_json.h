@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file api_json.h
+ * @brief JSON bodies of the button and LED REST endpoints
+ *
+ * Plain functions over caller-provided state, with no HTTP server or zbus
+ * dependency, so they can be tested and timed on their own.
+ */
+
+#ifndef API_JSON_H
+#define API_JSON_H
+
+#include "../messages.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** One button as reported by GET /api/buttons */
+struct api_json_button {
+	uint8_t number;
+	bool pressed;
+	uint32_t count;
+	uint32_t bounces;
+};
+
+/**
+ * @brief Serialize button states, e.g. {"buttons":[{"number":0,...}]}
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @param buttons Button states
+ * @param count Number of buttons
+ * @return Number of bytes written, or -ENOMEM if the buffer is too small
+ */
+int api_json_buttons(char *buf, size_t buf_len,
+		     const struct api_json_button *buttons, size_t count);
+
+/**
+ * @brief Serialize LED states, e.g. {"leds":[{"number":0,...}]}
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @param is_on State of each LED, indexed by LED number
+ * @param count Number of LEDs
+ * @return Number of bytes written, or -ENOMEM if the buffer is too small
+ */
+int api_json_leds(char *buf, size_t buf_len, const bool *is_on, size_t count);
+
+/**
+ * @brief Parse a POST /api/led body, e.g. {"led":0,"action":"toggle"}
+ *
+ * @param body Request body, tokenized in place
+ * @param len Body length
+ * @param num_leds Number of LEDs on the board
+ * @param msg Filled with the command
+ * @return 0 on success, -ERANGE if the LED does not exist, -ENOTSUP for an
+ *         unknown action, or another negative error code if the body is
+ *         not a command
+ */
+int api_json_led_cmd_parse(char *body, size_t len, uint8_t num_leds,
+			   struct led_msg *msg);
+
+#endif /* API_JSON_H */
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "led_api.h"
+#include "api_json.h"
+#include "../app_trace.h"
+#include "../latency/latency_trace.h"
+#include "../led/led.h"
+#include "../log_ratelimit.h"
+#include "../messages.h"
+#include "../zbus_stats/zbus_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(webserver_module, CONFIG_WEBSERVER_MODULE_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#define NUM_LEDS APP_NUM_LEDS
+
+extern const struct zbus_channel LED_CMD_CHAN;
+
+int led_api_states_json(char *buf, size_t buf_len)
+{
+	bool is_on[NUM_LEDS];
+
+	for (int i = 0; i < NUM_LEDS; i++) {
+		is_on[i] = false;
+		led_get_state(i, &is_on[i]);
+	}
+
+	return api_json_leds(buf, buf_len, is_on, NUM_LEDS);
+}
+
+#if defined(CONFIG_WEBSERVER_WORKQ_LED)
+/* Validated commands waiting for the work queue. The publish may wait up
+ * to 100 ms for the channel and runs the LED state machine in the
+ * listener, none of which delays the HTTP server thread.
+ */
+K_MSGQ_DEFINE(led_cmd_msgq, sizeof(struct led_msg),
+	      CONFIG_WEBSERVER_WORKQ_LED_QUEUE_LEN, 4);
+
+static struct k_work_q *led_cmd_workq;
+
+void led_api_cmd_flush(void)
+{
+	struct led_msg msg;
+	int ret;
+
+	while (k_msgq_get(&led_cmd_msgq, &msg, K_NO_WAIT) == 0) {
+		/* The parse stage ran on the HTTP server thread and is not
+		 * part of the trace
+		 */
+		latency_trace_begin(LATENCY_PATH_LED);
+		APP_TRACE_BEGIN("led_cmd_pub", msg.led_number);
+		ret = zbus_stats_pub(&LED_CMD_CHAN, &msg, K_MSEC(100));
+		APP_TRACE_END("led_cmd_pub", msg.led_number);
+		latency_trace_mark(LATENCY_LED_PUBLISHED);
+		latency_trace_end(LATENCY_PATH_LED, msg.led_number);
+
+		if (ret < 0) {
+			APP_LOG_ERR_RL("Failed to publish LED command: %d",
+				       ret);
+		} else {
+			APP_LOG_INF_RL("LED control: LED %d, command %d",
+				       msg.led_number, msg.type);
+		}
+	}
+}
+
+static void led_cmd_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	led_api_cmd_flush();
+}
+
+static K_WORK_DEFINE(led_cmd_work, led_cmd_work_fn);
+
+void led_api_init(struct k_work_q *workq)
+{
+	led_cmd_workq = workq;
+}
+#endif /* CONFIG_WEBSERVER_WORKQ_LED */
+
+void led_api_cmd_process(const struct http_request_ctx *request_ctx,
+			 struct http_response_ctx *response_ctx)
+{
+	/* Deferred commands are traced from the work queue */
+	if (!IS_ENABLED(CONFIG_WEBSERVER_WORKQ_LED)) {
+		latency_trace_begin(LATENCY_PATH_LED);
+	}
+
+	struct led_msg msg;
+	int ret = api_json_led_cmd_parse((char *)request_ctx->data,
+					 request_ctx->data_len, NUM_LEDS, &msg);
+
+	if (ret == -ERANGE) {
+		APP_LOG_WRN_RL("LED command out of range (max: %d)",
+			       NUM_LEDS - 1);
+		response_ctx->status = HTTP_400_BAD_REQUEST;
+		return;
+	} else if (ret == -ENOTSUP) {
+		APP_LOG_WRN_RL("Unknown LED action");
+		response_ctx->status = HTTP_400_BAD_REQUEST;
+		return;
+	} else if (ret < 0) {
+		APP_LOG_WRN_RL("Failed to parse LED command: %d", ret);
+		response_ctx->status = HTTP_400_BAD_REQUEST;
+		return;
+	}
+
+	latency_trace_mark(LATENCY_LED_PARSED);
+
+#if defined(CONFIG_WEBSERVER_WORKQ_LED)
+	if (k_msgq_put(&led_cmd_msgq, &msg, K_NO_WAIT) < 0) {
+		APP_LOG_WRN_RL("LED command queue full, LED %d dropped",
+			       msg.led_number);
+		response_ctx->status = HTTP_503_SERVICE_UNAVAILABLE;
+	} else {
+		k_work_submit_to_queue(led_cmd_workq, &led_cmd_work);
+		response_ctx->status = HTTP_202_ACCEPTED;
+	}
+#else
+	APP_TRACE_BEGIN("led_cmd_pub", msg.led_number);
+	ret = zbus_stats_pub(&LED_CMD_CHAN, &msg, K_MSEC(100));
+	APP_TRACE_END("led_cmd_pub", msg.led_number);
+	latency_trace_mark(LATENCY_LED_PUBLISHED);
+	latency_trace_end(LATENCY_PATH_LED, msg.led_number);
+	if (ret < 0) {
+		APP_LOG_ERR_RL("Failed to publish LED command: %d", ret);
+		response_ctx->status = HTTP_500_INTERNAL_SERVER_ERROR;
+	} else {
+		APP_LOG_INF_RL("LED control: LED %d, command %d",
+			       msg.led_number, msg.type);
+		response_ctx->status = HTTP_200_OK;
+	}
+#endif /* CONFIG_WEBSERVER_WORKQ_LED */
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file led_api.h
+ * @brief LED states and commands behind GET /api/leds and POST /api/led
+ *
+ * The HTTP resources in webserver.c apply admission control and send the
+ * response, these do the work in between. They use the LED module and
+ * LED_CMD_CHAN but not the HTTP server, so tests/api_json runs them with
+ * synthetic requests.
+ */
+
+#ifndef LED_API_H
+#define LED_API_H
+
+#include <stddef.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
+
+/**
+ * @brief Serialize the state of every LED as the /api/leds body
+ * @return Length written, or negative error code
+ */
+int led_api_states_json(char *buf, size_t buf_len);
+
+/**
+ * @brief Validate and dispatch a POST /api/led command
+ *
+ * Sets response_ctx->status: 200 once published, 202 once queued with
+ * CONFIG_WEBSERVER_WORKQ_LED, 400 for a malformed or out-of-range
+ * command, 500 when the publish fails and 503 when the queue is full.
+ * The request body is tokenized in place.
+ */
+void led_api_cmd_process(const struct http_request_ctx *request_ctx,
+			 struct http_response_ctx *response_ctx);
+
+#if defined(CONFIG_WEBSERVER_WORKQ_LED)
+/**
+ * @brief Set the work queue that publishes queued commands
+ */
+void led_api_init(struct k_work_q *workq);
+
+/**
+ * @brief Publish the queued commands on the calling thread
+ */
+void led_api_cmd_flush(void);
+#else
+static inline void led_api_init(struct k_work_q *workq)
+{
+	ARG_UNUSED(workq);
+}
+
+static inline void led_api_cmd_flush(void)
+{
+}
+#endif /* CONFIG_WEBSERVER_WORKQ_LED */
+
+#endif /* LED_API_H */
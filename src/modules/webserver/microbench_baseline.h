@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file microbench_baseline.h
+ * @brief Reference results of the /api/sys/microbench and tests/api_json
+ *        cases
+ *
+ * Bytes are those of the tests/api_json data set: four buttons, four LEDs
+ * with the even ones on, and commands for the last LED (in range) and the
+ * one after it (out of range). They do not depend on the board, and the
+ * suite fails on any difference.
+ *
+ * Cycles per call depend on the board, so each measured board has its own
+ * block. The suite fails on a board with a cycle clock that has none,
+ * after printing the lines to add. Record them with
+ * "west twister -p qemu_cortex_m3 -T tests/api_json". On hardware, run
+ * POST /api/sys/microbench with the default configuration and copy the
+ * "cycles" of each case. native_sim does not advance its clock while code
+ * runs and has no block. Update the numbers in the same commit as a change
+ * that is meant to move them, so every other change is compared against
+ * the last accepted cost.
+ */
+
+#ifndef MICROBENCH_BASELINE_H
+#define MICROBENCH_BASELINE_H
+
+#define MICROBENCH_BYTES_BUTTON_JSON     299
+#define MICROBENCH_BYTES_LED_JSON        176
+#define MICROBENCH_BYTES_LED_PARSE       24
+#define MICROBENCH_BYTES_LED_POST        24
+#define MICROBENCH_BYTES_LED_POST_REJECT 24
+
+/* Per-board cycle blocks go here, guarded by CONFIG_BOARD_<BOARD> and
+ * defining every MICROBENCH_BASELINE_<CASE> below
+ */
+
+#if defined(MICROBENCH_BASELINE_BUTTON_JSON)
+#define MICROBENCH_BASELINE_RECORDED        1
+#else
+/* Zero: no baseline, the app reports the cycles without a delta */
+#define MICROBENCH_BASELINE_RECORDED        0
+#define MICROBENCH_BASELINE_BUTTON_JSON     0
+#define MICROBENCH_BASELINE_LED_JSON        0
+#define MICROBENCH_BASELINE_LED_PARSE       0
+#define MICROBENCH_BASELINE_LED_POST        0
+#define MICROBENCH_BASELINE_LED_POST_REJECT 0
+#endif
+
+#endif /* MICROBENCH_BASELINE_H */
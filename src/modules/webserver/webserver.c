@@ -5,20 +5,69 @@
  */
 
 #include "webserver.h"
+#include "api_json.h"
+#include "led_api.h"
+#include "../app_trace.h"
 #include "../button/button.h"
 #include "../led/led.h"
+#include "../boot/boot_timeline.h"
+#include "../latency/latency_trace.h"
+#include "../log_ratelimit.h"
 #include "../messages.h"
+#include "../state_store/state_store.h"
+#include "../zbus_stats/zbus_stats.h"
+
+#if defined(CONFIG_APP_ASSET_FS)
+#include "../asset_fs/asset_fs.h"
+#endif
+#if defined(CONFIG_APP_DHCP_LEASE_CACHE)
+#include "../dhcp_cache/dhcp_cache.h"
+#endif
+#if defined(CONFIG_APP_LOG_RING)
+#include "../log_ring/log_ring.h"
+#endif
+#if defined(CONFIG_NETWORK_STATION_STATS)
+#include "../network/network.h"
+#endif
+#if defined(CONFIG_APP_HEAP_MONITOR)
+#include "../memory/heap_monitor.h"
+#endif
+#if defined(CONFIG_APP_NET_TELEMETRY)
+#include "../telemetry/net_telemetry.h"
+#endif
+#if defined(CONFIG_APP_THREAD_TELEMETRY)
+#include "../telemetry/thread_telemetry.h"
+#endif
+#if defined(CONFIG_WEBSERVER_MICROBENCH)
+#include "microbench_baseline.h"
+#endif
+#if defined(CONFIG_APP_RULES)
+#include "../rules/rules.h"
+#endif
+#if defined(CONFIG_WIFI_RECOVERY)
+#include "../wifi/wifi.h"
+#endif
+#if defined(CONFIG_APP_ZPERF)
+#include "../zperf/zperf_service.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(webserver_module, CONFIG_WEBSERVER_MODULE_LOG_LEVEL);
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <zephyr/data/json.h>
 #include <zephyr/kernel.h>
+#include <zephyr/net/http/server.h>
 #include <zephyr/net/http/service.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/socket.h>
 #include <zephyr/smf.h>
+#include <zephyr/sys/byteorder.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
 #include <zephyr/zbus/zbus.h>
 
 #define NUM_BUTTONS     APP_NUM_BUTTONS
@@ -39,36 +88,32 @@ BUILD_ASSERT(MAX_WEB_CLIENTS > 0, "At least one web client must be allowed");
  * ============================================================================
  */
 
-struct button_state {
-	bool is_pressed;
-	uint32_t press_count;
-	uint8_t button_number;
-};
-
-static struct button_state button_states[NUM_BUTTONS];
+/* Bounce counts are filled in when the states are serialized */
+static struct api_json_button button_states[NUM_BUTTONS];
 
 static void button_listener(const struct zbus_channel *chan)
 {
 	const struct button_msg *msg = zbus_chan_const_msg(chan);
 
+	latency_trace_mark(LATENCY_BTN_LISTENER);
+
 	if (msg->button_number < NUM_BUTTONS) {
 		int idx = msg->button_number;
-		button_states[idx].button_number = msg->button_number;
-		button_states[idx].press_count = msg->press_count;
-		button_states[idx].is_pressed = (msg->type == BUTTON_PRESSED);
+		button_states[idx].number = msg->button_number;
+		button_states[idx].count = msg->press_count;
+		button_states[idx].pressed = (msg->type == BUTTON_PRESSED);
 
 		LOG_DBG("Button %d state updated: %s, count=%d",
 			msg->button_number,
-			button_states[idx].is_pressed ? "pressed" : "released",
-			button_states[idx].press_count);
+			button_states[idx].pressed ? "pressed" : "released",
+			button_states[idx].count);
 	}
 }
 
-ZBUS_LISTENER_DEFINE(button_listener_def, button_listener);
+ZBUS_STATS_LISTENER_DEFINE(button_listener_def, button_listener);
 
 /* Extern reference to channels */
 extern const struct zbus_channel BUTTON_CHAN;
-extern const struct zbus_channel LED_CMD_CHAN;
 ZBUS_CHAN_ADD_OBS(BUTTON_CHAN, button_listener_def, 0);
 
 /* ============================================================================
@@ -85,295 +130,2659 @@ HTTP_SERVICE_DEFINE(webserver_service, NULL, &http_service_port,
  * ============================================================================
  */
 
-/* Index HTML */
-static const uint8_t index_html_gz[] = {
-#include "index.html.gz.inc"
+#if defined(CONFIG_WEBSERVER_ASSETS_FLASH_STREAM)
+/* The gzip arrays are served by a dynamic handler that points the response
+ * body straight at flash. The TCP stack copies each segment into its TX
+ * buffers once, as with a static resource, but the response can carry
+ * cache headers so a reload only fetches the page itself.
+ */
+struct flash_asset {
+	/* File name of an uploaded replacement (CONFIG_APP_ASSET_FS) */
+	const char *name;
+	const uint8_t *data;
+	size_t len;
+	const struct http_header *headers;
+	size_t header_count;
+};
+
+static const struct http_header asset_page_headers[] = {
+	{.name = "Content-Encoding", .value = "gzip"},
+	{.name = "Cache-Control", .value = "no-cache"},
+};
+
+#if defined(CONFIG_WEBSERVER_ASSET_MAX_AGE)
+static const struct http_header asset_cached_headers[] = {
+	{.name = "Content-Encoding", .value = "gzip"},
+	{.name = "Cache-Control",
+	 .value = "max-age=" STRINGIFY(CONFIG_WEBSERVER_ASSET_MAX_AGE)},
+};
+#else
+#define asset_cached_headers asset_page_headers
+#endif
+
+#if defined(CONFIG_APP_ASSET_FS)
+/* An upload can replace any asset at any time, so every asset is
+ * revalidated. The ETag is the gzip trailer (CRC-32 and length of the
+ * content), which turns the revalidation of an unchanged asset into a
+ * 304 without a body. Headers go out with the first chunk, so one value
+ * for the response in progress is enough.
+ */
+static char asset_etag[sizeof("\"01234567-01234567\"")];
+
+static const struct http_header asset_tagged_headers[] = {
+	{.name = "Content-Encoding", .value = "gzip"},
+	{.name = "Cache-Control", .value = "no-cache"},
+	{.name = "ETag", .value = asset_etag},
+};
+
+static const struct http_header asset_not_modified_headers[] = {
+	{.name = "Cache-Control", .value = "no-cache"},
+	{.name = "ETag", .value = asset_etag},
+};
+
+HTTP_SERVER_REGISTER_HEADER_CAPTURE(asset_if_none_match, "If-None-Match");
+
+/* Set the ETag of the content, true if the client already holds it */
+static bool asset_etag_match(const struct http_request_ctx *request_ctx,
+			     uint32_t crc32, uint32_t isize)
+{
+	snprintf(asset_etag, sizeof(asset_etag), "\"%08x-%x\"", crc32, isize);
+
+	for (size_t i = 0; i < request_ctx->header_count; i++) {
+		if (strcasecmp(request_ctx->headers[i].name, "If-None-Match") ==
+			    0 &&
+		    strstr(request_ctx->headers[i].value, asset_etag)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void asset_not_modified(struct http_response_ctx *response_ctx)
+{
+	response_ctx->headers = asset_not_modified_headers;
+	response_ctx->header_count = ARRAY_SIZE(asset_not_modified_headers);
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_304_NOT_MODIFIED;
+}
+
+/* Uploaded replacement being sent, one response at a time */
+static struct asset_fs_stream asset_stream;
+static const struct http_client_ctx *asset_stream_client;
+static const struct flash_asset *asset_stream_asset;
+
+static void asset_fs_stream_end(const struct http_client_ctx *client)
+{
+	if (client == NULL || client == asset_stream_client) {
+		asset_fs_close(&asset_stream);
+		asset_stream_client = NULL;
+		asset_stream_asset = NULL;
+	}
+}
+
+/* Send the next chunk of an uploaded replacement. Returns -ENOENT when
+ * none is stored (or it cannot be opened) so the built-in copy is sent.
+ */
+static int asset_fs_respond(const struct http_client_ctx *client,
+			    const struct flash_asset *asset,
+			    const struct http_request_ctx *request_ctx,
+			    struct http_response_ctx *response_ctx)
+{
+	const uint8_t *data;
+	size_t len;
+	int ret;
+
+	if (asset_stream_client != client || asset_stream_asset != asset) {
+		asset_fs_stream_end(NULL);
+
+		ret = asset_fs_open(&asset_stream, asset->name);
+		if (ret < 0) {
+			if (ret != -ENOENT) {
+				LOG_WRN("Stored %s unreadable (%d), using built-in",
+					asset->name, ret);
+			}
+			return -ENOENT;
+		}
+
+		if (asset_etag_match(request_ctx, asset_stream.crc32,
+				     asset_stream.isize)) {
+			asset_fs_close(&asset_stream);
+			asset_not_modified(response_ctx);
+			return 0;
+		}
+
+		asset_stream_client = client;
+		asset_stream_asset = asset;
+		response_ctx->headers = asset_tagged_headers;
+		response_ctx->header_count = ARRAY_SIZE(asset_tagged_headers);
+	}
+
+	ret = asset_fs_read(&asset_stream, &data, &len);
+	if (ret != 0) {
+		asset_fs_stream_end(NULL);
+	}
+	if (ret < 0) {
+		/* Headers are out, all that is left is to drop the connection */
+		LOG_ERR("Reading stored %s failed: %d", asset->name, ret);
+		return ret == -ENOENT ? -EIO : ret;
+	}
+
+	response_ctx->body = data;
+	response_ctx->body_len = len;
+	response_ctx->final_chunk = (ret == 1);
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+#else
+static inline void asset_fs_stream_end(const struct http_client_ctx *client)
+{
+	ARG_UNUSED(client);
+}
+#endif /* CONFIG_APP_ASSET_FS */
+
+static int flash_asset_handler(struct http_client_ctx *client,
+			       enum http_data_status status,
+			       const struct http_request_ctx *request_ctx,
+			       struct http_response_ctx *response_ctx,
+			       void *user_data)
+{
+	const struct flash_asset *asset = user_data;
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		asset_fs_stream_end(client);
+		return 0;
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+#if defined(CONFIG_APP_ASSET_FS)
+	int ret = asset_fs_respond(client, asset, request_ctx, response_ctx);
+
+	if (ret != -ENOENT) {
+		/* The page is usually the first thing a client gets */
+		if (ret == 0 && response_ctx->final_chunk) {
+			boot_timeline_mark(BOOT_PHASE_FIRST_RESPONSE);
+		}
+		return ret;
+	}
+
+	/* The built-in copy is tagged from its own trailer */
+	const uint8_t *trailer = asset->data + asset->len - 8;
+
+	if (asset_etag_match(request_ctx, sys_get_le32(trailer),
+			     sys_get_le32(trailer + 4))) {
+		asset_not_modified(response_ctx);
+		boot_timeline_mark(BOOT_PHASE_FIRST_RESPONSE);
+		return 0;
+	}
+
+	response_ctx->headers = asset_tagged_headers;
+	response_ctx->header_count = ARRAY_SIZE(asset_tagged_headers);
+#else
+	ARG_UNUSED(request_ctx);
+
+	response_ctx->headers = asset->headers;
+	response_ctx->header_count = asset->header_count;
+#endif
+	response_ctx->body = asset->data;
+	response_ctx->body_len = asset->len;
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_200_OK;
+
+	boot_timeline_mark(BOOT_PHASE_FIRST_RESPONSE);
+
+	return 0;
+}
+
+#define ASSET_DEFINE(_name, _file, _path, _type, _headers)                     \
+	static const struct flash_asset _name##_asset = {                      \
+		.name = _file,                                                 \
+		.data = _name##_gz,                                            \
+		.len = sizeof(_name##_gz),                                     \
+		.headers = _headers,                                           \
+		.header_count = ARRAY_SIZE(_headers),                          \
+	};                                                                     \
+	static struct http_resource_detail_dynamic _name##_resource_detail = { \
+		.common = {                                                    \
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,                    \
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),    \
+			.content_type = _type,                                 \
+		},                                                             \
+		.cb = flash_asset_handler,                                     \
+		.holder = NULL,                                                \
+		.user_data = (void *)&_name##_asset,                           \
+	};                                                                     \
+	HTTP_RESOURCE_DEFINE(_name##_resource, webserver_service, _path,       \
+			     &_name##_resource_detail)
+#else
+#define ASSET_DEFINE(_name, _file, _path, _type, _headers)                     \
+	static struct http_resource_detail_static _name##_resource_detail = {  \
+		.common = {                                                    \
+			.type = HTTP_RESOURCE_TYPE_STATIC,                     \
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),    \
+			.content_encoding = "gzip",                            \
+			.content_type = _type,                                 \
+		},                                                             \
+		.static_data = _name##_gz,                                     \
+		.static_data_len = sizeof(_name##_gz),                         \
+	};                                                                     \
+	HTTP_RESOURCE_DEFINE(_name##_resource, webserver_service, _path,       \
+			     &_name##_resource_detail)
+#endif /* CONFIG_WEBSERVER_ASSETS_FLASH_STREAM */
+
+/* Index HTML */
+static const uint8_t index_html_gz[] = {
+#include "index.html.gz.inc"
+};
+
+ASSET_DEFINE(index_html, "index.html", "/", "text/html", asset_page_headers);
+
+/* Main JS */
+static const uint8_t main_js_gz[] = {
+#include "main.js.gz.inc"
+};
+
+ASSET_DEFINE(main_js, "main.js", "/main.js", "application/javascript",
+	     asset_cached_headers);
+
+/* Styles CSS */
+static const uint8_t styles_css_gz[] = {
+#include "styles.css.gz.inc"
+};
+
+ASSET_DEFINE(styles_css, "styles.css", "/styles.css", "text/css",
+	     asset_cached_headers);
+
+#if defined(CONFIG_APP_ASSET_FS)
+static const struct flash_asset *const uploadable_assets[] = {
+	&index_html_asset,
+	&main_js_asset,
+	&styles_css_asset,
+};
+
+static bool asset_name_known(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(uploadable_assets); i++) {
+		if (strcmp(uploadable_assets[i]->name, name) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_APP_ASSET_FS */
+
+/* ============================================================================
+ * REQUEST HELPERS
+ * ============================================================================
+ */
+
+/* Copy the value of a query string parameter from the request URL */
+static int __maybe_unused query_param_get(const struct http_client_ctx *client,
+					  const char *key, char *value,
+					  size_t value_len)
+{
+	const char *query = strchr((const char *)client->url_buffer, '?');
+	const size_t key_len = strlen(key);
+
+	while (query) {
+		query++;
+		if (strncmp(query, key, key_len) == 0 && query[key_len] == '=') {
+			const char *start = query + key_len + 1;
+			const size_t len = strcspn(start, "&");
+
+			if (len >= value_len) {
+				return -ENOMEM;
+			}
+			memcpy(value, start, len);
+			value[len] = '\0';
+			return len;
+		}
+		query = strchr(query, '&');
+	}
+
+	return -ENOENT;
+}
+
+/* ============================================================================
+ * ADMISSION CONTROL
+ * ============================================================================
+ */
+
+#if defined(CONFIG_WEBSERVER_ADMISSION)
+/* Written by the REST handlers on the HTTP server thread */
+static bool admission_pressure;
+static uint32_t admission_shed;
+
+static const struct http_header admission_headers[] = {
+	{.name = "Retry-After",
+	 .value = STRINGIFY(CONFIG_WEBSERVER_ADMISSION_RETRY_AFTER_S)},
+};
+
+/* Enter pressure below the thresholds, leave it above twice the
+ * thresholds, so that the state does not flap at the boundary
+ */
+static bool admission_update(void)
+{
+	const uint32_t scale = admission_pressure ? 2U : 1U;
+	struct net_telemetry_usage tx_pkts = {0};
+	struct net_telemetry_usage tx_bufs = {0};
+	size_t heap_free = SIZE_MAX;
+	size_t heap_total;
+	bool low;
+
+	net_telemetry_usage_get(NET_TELEMETRY_TX_PKTS, &tx_pkts);
+	net_telemetry_usage_get(NET_TELEMETRY_TX_BUFS, &tx_bufs);
+	heap_monitor_free_get(&heap_free, &heap_total);
+
+	low = tx_pkts.free < CONFIG_WEBSERVER_ADMISSION_MIN_TX_PKTS * scale ||
+	      tx_bufs.free < CONFIG_WEBSERVER_ADMISSION_MIN_TX_BUFS * scale ||
+	      heap_free < CONFIG_WEBSERVER_ADMISSION_MIN_HEAP_BYTES * scale;
+
+	if (low != admission_pressure) {
+		admission_pressure = low;
+		if (low) {
+			LOG_WRN("Shedding load: tx_pkts=%u tx_bufs=%u heap=%zu",
+				tx_pkts.free, tx_bufs.free, heap_free);
+		} else {
+			LOG_INF("Load shedding ended, %u requests rejected",
+				admission_shed);
+			admission_shed = 0;
+		}
+	}
+
+	return !low;
+}
+
+/* Answer 503 with Retry-After instead of running the handler. The reply
+ * carries no body, so it needs at most one TX buffer.
+ */
+static bool admission_check(struct http_response_ctx *response_ctx)
+{
+	if (admission_update()) {
+		return true;
+	}
+
+	admission_shed++;
+	response_ctx->status = HTTP_503_SERVICE_UNAVAILABLE;
+	response_ctx->headers = admission_headers;
+	response_ctx->header_count = ARRAY_SIZE(admission_headers);
+	response_ctx->final_chunk = true;
+
+	return false;
+}
+
+static inline bool admission_pressure_get(void)
+{
+	return admission_pressure;
+}
+#else
+static inline bool admission_check(struct http_response_ctx *response_ctx)
+{
+	ARG_UNUSED(response_ctx);
+	return true;
+}
+
+static inline bool admission_pressure_get(void)
+{
+	return false;
+}
+#endif /* CONFIG_WEBSERVER_ADMISSION */
+
+/* ============================================================================
+ * POLL RATE HINT
+ * ============================================================================
+ */
+
+#if defined(CONFIG_WEBSERVER_POLL_HINT)
+/* State requests issued by one UI poll cycle (buttons and LEDs) */
+#define POLL_REQUESTS_PER_CYCLE 2
+
+struct poll_peer {
+	struct in_addr addr;
+	int64_t last_seen;
+};
+
+/* Only touched from the HTTP server thread */
+static struct poll_peer poll_peers[MAX_WEB_CLIENTS];
+static int64_t poll_window_start;
+static uint32_t poll_window_requests;
+static uint32_t poll_last_rps;
+static char poll_hint_value[6];
+
+static const struct http_header poll_hint_headers[] = {
+	{.name = "X-Poll-Interval", .value = poll_hint_value},
+};
+
+/* Record the request and return the number of active polling stations */
+static int poll_track(const struct http_client_ctx *client, int64_t now)
+{
+	struct sockaddr_in peer;
+	socklen_t peer_len = sizeof(peer);
+	struct poll_peer *slot = NULL;
+	int active = 0;
+
+	if (now - poll_window_start >= MSEC_PER_SEC) {
+		poll_last_rps = poll_window_requests * MSEC_PER_SEC /
+				(uint32_t)(now - poll_window_start);
+		poll_window_start = now;
+		poll_window_requests = 0;
+	}
+	poll_window_requests++;
+
+	/* Browsers open several connections, so stations are told apart
+	 * by address rather than by connection
+	 */
+	if (zsock_getpeername(client->fd, (struct sockaddr *)&peer,
+			      &peer_len) == 0 &&
+	    peer.sin_family == AF_INET) {
+		for (int i = 0; i < ARRAY_SIZE(poll_peers); i++) {
+			struct poll_peer *p = &poll_peers[i];
+
+			if (p->addr.s_addr == peer.sin_addr.s_addr) {
+				slot = p;
+				break;
+			}
+			if (!slot || p->last_seen < slot->last_seen) {
+				slot = p;
+			}
+		}
+		slot->addr = peer.sin_addr;
+		slot->last_seen = now;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(poll_peers); i++) {
+		const int64_t idle = now - poll_peers[i].last_seen;
+
+		if (poll_peers[i].last_seen != 0 &&
+		    idle < CONFIG_WEBSERVER_POLL_ACTIVE_MS) {
+			active++;
+		}
+	}
+
+	return MAX(active, 1);
+}
+
+/* Attach the advertised poll interval to a state response */
+static void poll_hint_apply(const struct http_client_ctx *client,
+			    struct http_response_ctx *response_ctx)
+{
+	int64_t now = k_uptime_get();
+	int active = poll_track(client, now);
+	uint32_t interval;
+
+	/* Spread the request budget over all active stations */
+	interval = active * POLL_REQUESTS_PER_CYCLE * MSEC_PER_SEC /
+		   CONFIG_WEBSERVER_POLL_BUDGET_RPS;
+
+	/* Stretch further while the measured rate is above budget */
+	if (poll_last_rps > CONFIG_WEBSERVER_POLL_BUDGET_RPS) {
+		interval = interval * poll_last_rps /
+			   CONFIG_WEBSERVER_POLL_BUDGET_RPS;
+	}
+
+	interval = CLAMP(interval, CONFIG_WEBSERVER_POLL_MIN_MS,
+			 CONFIG_WEBSERVER_POLL_MAX_MS);
+
+	/* Buffers or heap are short: spread the stations out as far as
+	 * possible
+	 */
+	if (admission_pressure_get()) {
+		interval = CONFIG_WEBSERVER_POLL_MAX_MS;
+	}
+
+	snprintf(poll_hint_value, sizeof(poll_hint_value), "%u", interval);
+	response_ctx->headers = poll_hint_headers;
+	response_ctx->header_count = ARRAY_SIZE(poll_hint_headers);
+}
+#else
+static inline void poll_hint_apply(const struct http_client_ctx *client,
+				   struct http_response_ctx *response_ctx)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(response_ctx);
+}
+#endif /* CONFIG_WEBSERVER_POLL_HINT */
+
+/* ============================================================================
+ * HANDLER TIMING
+ * ============================================================================
+ */
+
+enum handler_timing_id {
+	TIMING_BUTTONS_GET,
+	TIMING_LEDS_GET,
+	TIMING_LED_POST,
+	TIMING_COUNT,
+};
+
+#if defined(CONFIG_WEBSERVER_HANDLER_TIMING)
+struct handler_timing {
+	const char *name;
+	http_resource_dynamic_cb_t cb;
+	uint32_t count;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+};
+
+/* Defined with the handler table once all handlers are declared */
+static struct handler_timing handler_timings[TIMING_COUNT];
+
+/* Measure the final (request complete) invocation of the wrapped handler */
+static int timed_handler(struct http_client_ctx *client,
+			 enum http_data_status status,
+			 const struct http_request_ctx *request_ctx,
+			 struct http_response_ctx *response_ctx,
+			 void *user_data)
+{
+	struct handler_timing *timing = user_data;
+	const uint32_t start = k_cycle_get_32();
+	int ret = timing->cb(client, status, request_ctx, response_ctx, NULL);
+	const uint32_t cycles = k_cycle_get_32() - start;
+
+	if (status == HTTP_SERVER_DATA_FINAL) {
+		timing->count++;
+		timing->total_cycles += cycles;
+		timing->max_cycles = MAX(timing->max_cycles, cycles);
+	}
+
+	return ret;
+}
+
+#define HANDLER_CB(_cb)        timed_handler
+#define HANDLER_USER_DATA(_id) (&handler_timings[_id])
+#else
+#define HANDLER_CB(_cb)        _cb
+#define HANDLER_USER_DATA(_id) NULL
+#endif /* CONFIG_WEBSERVER_HANDLER_TIMING */
+
+/* ============================================================================
+ * DEFERRED WORK
+ * ============================================================================
+ */
+
+#if defined(CONFIG_WEBSERVER_WORKQ)
+/* The HTTP server runs every resource on one thread, so a handler that
+ * blocks holds up asset delivery to all clients. Handlers that may block
+ * validate the request, queue the rest here and answer at once.
+ */
+static K_THREAD_STACK_DEFINE(webserver_workq_stack,
+			     CONFIG_WEBSERVER_WORKQ_STACK_SIZE);
+static struct k_work_q webserver_workq;
+
+static void webserver_workq_start(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "httpd_work",
+	};
+
+	/* Same priority as the HTTP server thread: deferred work never
+	 * preempts request handling
+	 */
+	k_work_queue_start(&webserver_workq, webserver_workq_stack,
+			   K_THREAD_STACK_SIZEOF(webserver_workq_stack),
+			   K_LOWEST_APPLICATION_THREAD_PRIO, &cfg);
+	led_api_init(&webserver_workq);
+}
+#else
+static inline void webserver_workq_start(void)
+{
+}
+#endif /* CONFIG_WEBSERVER_WORKQ */
+
+/* ============================================================================
+ * DYNAMIC API ENDPOINTS
+ * ============================================================================
+ */
+
+/* GET /api/buttons - Get button states */
+static uint8_t button_api_buf[512];
+
+static int button_states_json(char *buf, size_t buf_len)
+{
+	for (int i = 0; i < NUM_BUTTONS; i++) {
+		button_bounce_count_get(button_states[i].number,
+					&button_states[i].bounces);
+	}
+
+	return api_json_buttons(buf, buf_len, button_states, NUM_BUTTONS);
+}
+
+static int button_api_handler(struct http_client_ctx *client,
+			      enum http_data_status status,
+			      const struct http_request_ctx *request_ctx,
+			      struct http_response_ctx *response_ctx,
+			      void *user_data)
+{
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	APP_TRACE_BEGIN("http_buttons", 0);
+	int written = button_states_json((char *)button_api_buf,
+					 sizeof(button_api_buf));
+	APP_TRACE_END("http_buttons", 0);
+	if (written < 0) {
+		return written;
+	}
+
+	boot_timeline_mark(BOOT_PHASE_FIRST_RESPONSE);
+	poll_hint_apply(client, response_ctx);
+
+	response_ctx->body = button_api_buf;
+	response_ctx->body_len = written;
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic button_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = HANDLER_CB(button_api_handler),
+	.holder = NULL,
+	.user_data = HANDLER_USER_DATA(TIMING_BUTTONS_GET),
+};
+
+HTTP_RESOURCE_DEFINE(button_api_resource, webserver_service, "/api/buttons",
+		     &button_api_detail);
+
+/* GET /api/leds - Get LED states */
+static uint8_t led_get_api_buf[512];
+
+static int led_get_api_handler(struct http_client_ctx *client,
+			       enum http_data_status status,
+			       const struct http_request_ctx *request_ctx,
+			       struct http_response_ctx *response_ctx,
+			       void *user_data)
+{
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	/* Get LED states */
+	APP_TRACE_BEGIN("http_leds", 0);
+	int written = led_api_states_json((char *)led_get_api_buf,
+					  sizeof(led_get_api_buf));
+	APP_TRACE_END("http_leds", 0);
+
+	if (written <= 0) {
+		APP_LOG_ERR_RL("Failed to serialize LED states: %d", written);
+		response_ctx->status = HTTP_500_INTERNAL_SERVER_ERROR;
+		response_ctx->final_chunk = true;
+		return 0;
+	}
+
+	boot_timeline_mark(BOOT_PHASE_FIRST_RESPONSE);
+	poll_hint_apply(client, response_ctx);
+	response_ctx->body = led_get_api_buf;
+	response_ctx->body_len = written;
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic led_get_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = HANDLER_CB(led_get_api_handler),
+	.holder = NULL,
+	.user_data = HANDLER_USER_DATA(TIMING_LEDS_GET),
+};
+
+HTTP_RESOURCE_DEFINE(led_get_api_resource, webserver_service, "/api/leds",
+		     &led_get_api_detail);
+
+/* POST /api/led - Control LED */
+static int led_post_api_handler(struct http_client_ctx *client,
+				enum http_data_status status,
+				const struct http_request_ctx *request_ctx,
+				struct http_response_ctx *response_ctx,
+				void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	APP_TRACE_BEGIN("http_led_post", 0);
+	led_api_cmd_process(request_ctx, response_ctx);
+	APP_TRACE_END("http_led_post", response_ctx->status);
+
+	response_ctx->final_chunk = true;
+	return 0;
+}
+
+static struct http_resource_detail_dynamic led_post_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_POST),
+		},
+	/* clang-format on */
+	.cb = HANDLER_CB(led_post_api_handler),
+	.holder = NULL,
+	.user_data = HANDLER_USER_DATA(TIMING_LED_POST),
+};
+
+HTTP_RESOURCE_DEFINE(led_post_api_resource, webserver_service, "/api/led",
+		     &led_post_api_detail);
+
+#if defined(CONFIG_WEBSERVER_HANDLER_TIMING)
+/* GET /api/sys/handlers - Handler latency statistics */
+static struct handler_timing handler_timings[TIMING_COUNT] = {
+	[TIMING_BUTTONS_GET] = {.name = "buttons_get",
+				.cb = button_api_handler},
+	[TIMING_LEDS_GET] = {.name = "leds_get", .cb = led_get_api_handler},
+	[TIMING_LED_POST] = {.name = "led_post", .cb = led_post_api_handler},
+};
+
+static uint8_t handler_timing_api_buf[512];
+
+static int handler_timing_api_handler(
+	struct http_client_ctx *client, enum http_data_status status,
+	const struct http_request_ctx *request_ctx,
+	struct http_response_ctx *response_ctx, void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	int offset = 0;
+	int remaining = sizeof(handler_timing_api_buf);
+	int written = snprintf((char *)handler_timing_api_buf, remaining,
+			       "{\"handlers\":[");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	for (int i = 0; i < TIMING_COUNT; i++) {
+		const struct handler_timing *timing = &handler_timings[i];
+		const uint32_t avg_cycles =
+			timing->count
+				? (uint32_t)(timing->total_cycles / timing->count)
+				: 0U;
+
+		written = snprintf(
+			(char *)handler_timing_api_buf + offset, remaining,
+			/* clang-format off */
+			"{\"name\":\"%s\",\"count\":%u,\"avg_cycles\":%u,"
+			"\"max_cycles\":%u,\"avg_us\":%u,\"max_us\":%u}%s",
+			/* clang-format on */
+			timing->name, timing->count, avg_cycles,
+			timing->max_cycles, k_cyc_to_us_floor32(avg_cycles),
+			k_cyc_to_us_floor32(timing->max_cycles),
+			(i == TIMING_COUNT - 1) ? "" : ",");
+		if (written < 0 || written >= remaining) {
+			return -ENOMEM;
+		}
+		offset += written;
+		remaining -= written;
+	}
+
+	written = snprintf((char *)handler_timing_api_buf + offset, remaining,
+			   "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+
+	response_ctx->body = handler_timing_api_buf;
+	response_ctx->body_len = offset;
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic handler_timing_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = handler_timing_api_handler,
+	.holder = NULL,
+	.user_data = NULL,
+};
+
+HTTP_RESOURCE_DEFINE(handler_timing_api_resource, webserver_service,
+		     "/api/sys/handlers", &handler_timing_api_detail);
+#endif /* CONFIG_WEBSERVER_HANDLER_TIMING */
+
+/* ============================================================================
+ * CAPTIVE PORTAL PROBES
+ * ============================================================================
+ */
+
+#if defined(CONFIG_WEBSERVER_CAPTIVE_PROBES)
+static const struct http_header captive_probe_headers[] = {
+	{.name = "Location",
+	 .value = "http://" CONFIG_NET_CONFIG_MY_IPV4_ADDR ":" STRINGIFY(
+		 CONFIG_APP_HTTP_PORT) "/"},
+	{.name = "Cache-Control", .value = "no-store"},
+};
+
+/* Any answer other than the expected one marks the network as captive */
+static int captive_probe_handler(struct http_client_ctx *client,
+				 enum http_data_status status,
+				 const struct http_request_ctx *request_ctx,
+				 struct http_response_ctx *response_ctx,
+				 void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+	ARG_UNUSED(user_data);
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	response_ctx->status = HTTP_302_FOUND;
+	response_ctx->headers = captive_probe_headers;
+	response_ctx->header_count = ARRAY_SIZE(captive_probe_headers);
+	response_ctx->final_chunk = true;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic captive_probe_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "text/plain",
+		},
+	/* clang-format on */
+	.cb = captive_probe_handler,
+	.holder = NULL,
+	.user_data = NULL,
+};
+
+#define CAPTIVE_PROBE_DEFINE(_name, _path)                                     \
+	HTTP_RESOURCE_DEFINE(_name, webserver_service, _path,                  \
+			     &captive_probe_detail)
+
+/* Android, ChromeOS */
+CAPTIVE_PROBE_DEFINE(probe_generate_204, "/generate_204");
+CAPTIVE_PROBE_DEFINE(probe_gen_204, "/gen_204");
+/* iOS, macOS */
+CAPTIVE_PROBE_DEFINE(probe_hotspot_detect, "/hotspot-detect.html");
+CAPTIVE_PROBE_DEFINE(probe_apple_success, "/library/test/success.html");
+/* Windows */
+CAPTIVE_PROBE_DEFINE(probe_connecttest, "/connecttest.txt");
+CAPTIVE_PROBE_DEFINE(probe_ncsi, "/ncsi.txt");
+CAPTIVE_PROBE_DEFINE(probe_redirect, "/redirect");
+/* Firefox */
+CAPTIVE_PROBE_DEFINE(probe_canonical, "/canonical.html");
+CAPTIVE_PROBE_DEFINE(probe_success_txt, "/success.txt");
+#endif /* CONFIG_WEBSERVER_CAPTIVE_PROBES */
+
+/* ============================================================================
+ * DIAGNOSTIC ENDPOINTS
+ * ============================================================================
+ */
+
+/* Serializer that renders a complete JSON document */
+typedef int (*json_snapshot_fn)(char *buf, size_t buf_len);
+
+struct json_snapshot {
+	json_snapshot_fn serialize;
+};
+
+static uint8_t __maybe_unused json_snapshot_buf[1024];
+
+/* Reply with the snapshot, for handlers that have passed admission */
+static int __maybe_unused json_snapshot_send(
+	struct http_response_ctx *response_ctx,
+	const struct json_snapshot *snapshot)
+{
+	int written = snapshot->serialize((char *)json_snapshot_buf,
+					  sizeof(json_snapshot_buf));
+	if (written < 0) {
+		LOG_ERR("JSON snapshot failed: %d", written);
+		response_ctx->status = HTTP_500_INTERNAL_SERVER_ERROR;
+		response_ctx->final_chunk = true;
+		return 0;
+	}
+
+	response_ctx->body = json_snapshot_buf;
+	response_ctx->body_len = written;
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+
+static int __maybe_unused json_snapshot_handler(
+	struct http_client_ctx *client, enum http_data_status status,
+	const struct http_request_ctx *request_ctx,
+	struct http_response_ctx *response_ctx, void *user_data)
+{
+	ARG_UNUSED(client);
+	ARG_UNUSED(request_ctx);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	return json_snapshot_send(response_ctx, user_data);
+}
+
+/* Producer that writes the next fragment of a JSON document */
+typedef int (*json_chunk_fn)(char *buf, size_t buf_len, uint32_t *cursor,
+			     bool *done);
+
+struct json_stream {
+	json_chunk_fn produce;
+	const struct http_client_ctx *client;
+	uint32_t cursor;
+	bool active;
+};
+
+/* All handlers run on the HTTP server thread, so one buffer is enough */
+static uint8_t __maybe_unused json_stream_buf[512];
+
+static int __maybe_unused json_stream_handler(
+	struct http_client_ctx *client, enum http_data_status status,
+	const struct http_request_ctx *request_ctx,
+	struct http_response_ctx *response_ctx, void *user_data)
+{
+	struct json_stream *stream = user_data;
+	bool done;
+
+	ARG_UNUSED(request_ctx);
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		stream->active = false;
+		return 0;
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	/* A new request, or the previous one was dropped mid-stream. Only a
+	 * new request is shed, one that is half sent has to finish.
+	 */
+	if (!stream->active || stream->client != client) {
+		if (!admission_check(response_ctx)) {
+			stream->active = false;
+			return 0;
+		}
+
+		stream->client = client;
+		stream->cursor = 0;
+		stream->active = true;
+	}
+
+	int written = stream->produce((char *)json_stream_buf,
+				      sizeof(json_stream_buf),
+				      &stream->cursor, &done);
+	if (written < 0) {
+		LOG_ERR("JSON stream failed: %d", written);
+		stream->active = false;
+		response_ctx->status = HTTP_500_INTERNAL_SERVER_ERROR;
+		response_ctx->final_chunk = true;
+		return 0;
+	}
+
+	if (done) {
+		stream->active = false;
+	}
+
+	response_ctx->body = json_stream_buf;
+	response_ctx->body_len = written;
+	response_ctx->final_chunk = done;
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+
+#if defined(CONFIG_NETWORK_STATION_STATS)
+/* GET /api/stations - Connected station table */
+static const struct json_snapshot station_api_snapshot = {
+	.serialize = network_stations_json,
+};
+
+static struct http_resource_detail_dynamic station_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = json_snapshot_handler,
+	.holder = NULL,
+	.user_data = (void *)&station_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(station_api_resource, webserver_service, "/api/stations",
+		     &station_api_detail);
+#endif /* CONFIG_NETWORK_STATION_STATS */
+
+#if defined(CONFIG_APP_BOOT_TIMELINE)
+/* GET /api/sys/boot - Boot phase timeline */
+static const struct json_snapshot boot_api_snapshot = {
+	.serialize = boot_timeline_json,
+};
+
+static struct http_resource_detail_dynamic boot_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = json_snapshot_handler,
+	.holder = NULL,
+	.user_data = (void *)&boot_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(boot_api_resource, webserver_service, "/api/sys/boot",
+		     &boot_api_detail);
+#endif /* CONFIG_APP_BOOT_TIMELINE */
+
+#if defined(CONFIG_WIFI_RECOVERY)
+/* GET /api/sys/wifi - SoftAP fault recovery statistics */
+static const struct json_snapshot wifi_api_snapshot = {
+	.serialize = wifi_recovery_json,
+};
+
+static struct http_resource_detail_dynamic wifi_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = json_snapshot_handler,
+	.holder = NULL,
+	.user_data = (void *)&wifi_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(wifi_api_resource, webserver_service, "/api/sys/wifi",
+		     &wifi_api_detail);
+#endif /* CONFIG_WIFI_RECOVERY */
+
+#if defined(CONFIG_APP_DHCP_LEASE_CACHE)
+/* GET /api/sys/dhcp - Lease cache and reconnect statistics */
+static const struct json_snapshot dhcp_api_snapshot = {
+	.serialize = dhcp_cache_json,
+};
+
+static struct http_resource_detail_dynamic dhcp_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = json_snapshot_handler,
+	.holder = NULL,
+	.user_data = (void *)&dhcp_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(dhcp_api_resource, webserver_service, "/api/sys/dhcp",
+		     &dhcp_api_detail);
+#endif /* CONFIG_APP_DHCP_LEASE_CACHE */
+
+#if defined(CONFIG_APP_RULES)
+/* GET /api/rules - Rule table and evaluation statistics
+ * POST /api/rules - Replace the rule table
+ */
+/* Room for a full table in the documented format */
+#define RULES_BODY_MAX (CONFIG_APP_RULES_MAX * 96 + 16)
+
+static char rules_body[RULES_BODY_MAX];
+static size_t rules_body_len;
+static bool rules_body_overflow;
+static const struct http_client_ctx *rules_client;
+
+static struct json_stream rules_stream = {
+	.produce = rules_json_chunk,
+};
+
+static int rules_api_handler(struct http_client_ctx *client,
+			     enum http_data_status status,
+			     const struct http_request_ctx *request_ctx,
+			     struct http_response_ctx *response_ctx,
+			     void *user_data)
+{
+	int ret;
+
+	ARG_UNUSED(user_data);
+
+	if (client->method != HTTP_POST) {
+		return json_stream_handler(client, status, request_ctx,
+					   response_ctx, &rules_stream);
+	}
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		rules_client = NULL;
+		return 0;
+	}
+
+	/* The body arrives in pieces, collect it before parsing */
+	if (rules_client != client) {
+		rules_client = client;
+		rules_body_len = 0;
+		rules_body_overflow = false;
+	}
+
+	if (request_ctx->data_len > sizeof(rules_body) - rules_body_len) {
+		rules_body_overflow = true;
+	} else if (request_ctx->data_len > 0) {
+		memcpy(rules_body + rules_body_len, request_ctx->data,
+		       request_ctx->data_len);
+		rules_body_len += request_ctx->data_len;
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	rules_client = NULL;
+
+	if (rules_body_overflow) {
+		response_ctx->status = HTTP_413_PAYLOAD_TOO_LARGE;
+	} else {
+		ret = rules_set_json(rules_body, rules_body_len);
+		if (ret < 0) {
+			APP_LOG_WRN_RL("Rule table rejected: %d", ret);
+		}
+		response_ctx->status =
+			ret < 0 ? HTTP_400_BAD_REQUEST : HTTP_200_OK;
+	}
+
+	response_ctx->final_chunk = true;
+	return 0;
+}
+
+static struct http_resource_detail_dynamic rules_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = rules_api_handler,
+	.holder = NULL,
+	.user_data = NULL,
+};
+
+HTTP_RESOURCE_DEFINE(rules_api_resource, webserver_service, "/api/rules",
+		     &rules_api_detail);
+#endif /* CONFIG_APP_RULES */
+
+#if defined(CONFIG_APP_RULES_BENCH)
+/* POST /api/rules/bench - Measure rule evaluation cost per table size
+ * GET /api/rules/bench - Results of the last run
+ */
+static const struct json_snapshot rules_bench_snapshot = {
+	.serialize = rules_bench_json,
+};
+
+static int rules_bench_handler(struct http_client_ctx *client,
+			       enum http_data_status status,
+			       const struct http_request_ctx *request_ctx,
+			       struct http_response_ctx *response_ctx,
+			       void *user_data)
+{
+	ARG_UNUSED(request_ctx);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	if (client->method == HTTP_POST && rules_bench_start() < 0) {
+		response_ctx->status = HTTP_409_CONFLICT;
+		response_ctx->final_chunk = true;
+		return 0;
+	}
+
+	return json_snapshot_send(response_ctx, user_data);
+}
+
+static struct http_resource_detail_dynamic rules_bench_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = rules_bench_handler,
+	.holder = NULL,
+	.user_data = (void *)&rules_bench_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(rules_bench_api_resource, webserver_service,
+		     "/api/rules/bench", &rules_bench_api_detail);
+#endif /* CONFIG_APP_RULES_BENCH */
+
+#if defined(CONFIG_APP_NET_TELEMETRY)
+/* GET /api/sys/net - Packet and buffer pool utilization, TCP counters
+ * POST /api/sys/net - Restart the lowest free counts, e.g. before a load run
+ */
+static const struct json_snapshot net_api_snapshot = {
+	.serialize = net_telemetry_json,
+};
+
+static int net_api_handler(struct http_client_ctx *client,
+			   enum http_data_status status,
+			   const struct http_request_ctx *request_ctx,
+			   struct http_response_ctx *response_ctx,
+			   void *user_data)
+{
+	ARG_UNUSED(request_ctx);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	if (client->method == HTTP_POST) {
+		net_telemetry_reset();
+	}
+
+	return json_snapshot_send(response_ctx, user_data);
+}
+
+static struct http_resource_detail_dynamic net_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = net_api_handler,
+	.holder = NULL,
+	.user_data = (void *)&net_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(net_api_resource, webserver_service, "/api/sys/net",
+		     &net_api_detail);
+#endif /* CONFIG_APP_NET_TELEMETRY */
+
+#if defined(CONFIG_APP_ASSET_FS)
+/* GET /api/assets - Uploaded assets and cache statistics
+ * POST /api/assets?name=<file> - Replace an asset with the gzip body
+ * DELETE /api/assets?name=<file> - Revert an asset to the built-in copy
+ */
+static const struct json_snapshot asset_api_snapshot = {
+	.serialize = asset_fs_json,
+};
+
+static const struct http_client_ctx *asset_upload_client;
+static int asset_upload_error;
+
+static enum http_status asset_api_error_status(int err)
+{
+	switch (err) {
+	case -EINVAL:
+	case -ENODATA:
+		return HTTP_400_BAD_REQUEST;
+	case -ENOENT:
+		return HTTP_404_NOT_FOUND;
+	case -EFBIG:
+		return HTTP_413_PAYLOAD_TOO_LARGE;
+	case -ENOSPC:
+		return HTTP_507_INSUFFICIENT_STORAGE;
+	default:
+		return HTTP_500_INTERNAL_SERVER_ERROR;
+	}
+}
+
+static int asset_name_param(const struct http_client_ctx *client, char *name)
+{
+	int ret = query_param_get(client, "name", name, ASSET_FS_NAME_MAX);
+
+	if (ret < 0 || !asset_name_known(name)) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int asset_api_handler(struct http_client_ctx *client,
+			     enum http_data_status status,
+			     const struct http_request_ctx *request_ctx,
+			     struct http_response_ctx *response_ctx,
+			     void *user_data)
+{
+	char name[ASSET_FS_NAME_MAX];
+	int ret;
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		if (asset_upload_client == client) {
+			asset_fs_write_end(false);
+			asset_upload_client = NULL;
+		}
+		return 0;
+	}
+
+	if (client->method == HTTP_POST) {
+		/* The body arrives in pieces, the first one opens the upload */
+		if (asset_upload_client != client) {
+			asset_upload_client = client;
+			asset_upload_error = asset_name_param(client, name);
+			if (asset_upload_error == 0) {
+				asset_upload_error = asset_fs_write_begin(name);
+			}
+		}
+
+		if (asset_upload_error == 0 && request_ctx->data_len > 0) {
+			asset_upload_error = asset_fs_write(
+				request_ctx->data, request_ctx->data_len);
+		}
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
+	}
+
+	/* An upload is already on flash by now, so only the others are shed */
+	if (client->method != HTTP_POST && !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	if (client->method == HTTP_POST) {
+		asset_upload_client = NULL;
+		ret = asset_fs_write_end(asset_upload_error == 0);
+		if (asset_upload_error < 0) {
+			ret = asset_upload_error;
+		}
+	} else if (client->method == HTTP_DELETE) {
+		ret = asset_name_param(client, name);
+		if (ret == 0) {
+			ret = asset_fs_remove(name);
+		}
+	} else {
+		ret = 0;
+	}
+
+	if (ret < 0) {
+		APP_LOG_WRN_RL("Asset request failed: %d", ret);
+		response_ctx->status = asset_api_error_status(ret);
+		response_ctx->final_chunk = true;
+		return 0;
+	}
+
+	return json_snapshot_send(response_ctx, user_data);
+}
+
+static struct http_resource_detail_dynamic asset_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST) |
+				BIT(HTTP_DELETE),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = asset_api_handler,
+	.holder = NULL,
+	.user_data = (void *)&asset_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(asset_api_resource, webserver_service, "/api/assets",
+		     &asset_api_detail);
+#endif /* CONFIG_APP_ASSET_FS */
+
+#if defined(CONFIG_WEBSERVER_ASSET_BENCH)
+/* POST /api/sys/assets opens a measurement window, GET reports it. The
+ * window samples the free TX packets and TX data buffers every
+ * millisecond and counts cycles on the HTTP server thread and the whole
+ * system, so loading the page inside the window gives the cost of one
+ * page load for the asset path built in.
+ */
+struct asset_bench {
+	k_tid_t httpd;
+	int64_t start;
+	int64_t end;
+	uint64_t httpd_cycles;
+	uint64_t busy_cycles;
+	size_t tx_pkt_min_free;
+	size_t tx_buf_min_free;
+};
+
+static struct asset_bench asset_bench;
+static struct k_spinlock asset_bench_lock;
+
+static void asset_bench_cycles(uint64_t *httpd, uint64_t *busy)
+{
+	k_thread_runtime_stats_t stats;
+
+	*httpd = 0;
+	if (asset_bench.httpd &&
+	    k_thread_runtime_stats_get(asset_bench.httpd, &stats) == 0) {
+		*httpd = stats.execution_cycles;
+	}
+
+	*busy = 0;
+	if (k_thread_runtime_stats_all_get(&stats) == 0) {
+		*busy = stats.total_cycles;
+	}
+}
+
+static void asset_bench_sample(struct k_timer *timer)
+{
+	struct k_mem_slab *rx_pkts, *tx_pkts;
+	struct net_buf_pool *rx_bufs, *tx_bufs;
+	uint64_t httpd, busy;
+	k_spinlock_key_t key;
+
+	net_pkt_get_info(&rx_pkts, &tx_pkts, &rx_bufs, &tx_bufs);
+
+	key = k_spin_lock(&asset_bench_lock);
+
+	asset_bench.tx_pkt_min_free = MIN(asset_bench.tx_pkt_min_free,
+					  k_mem_slab_num_free_get(tx_pkts));
+	asset_bench.tx_buf_min_free =
+		MIN(asset_bench.tx_buf_min_free,
+		    (size_t)atomic_get(&tx_bufs->avail_count));
+
+	if (k_uptime_get() - asset_bench.start >=
+	    CONFIG_WEBSERVER_ASSET_BENCH_WINDOW_MS) {
+		k_timer_stop(timer);
+		asset_bench_cycles(&httpd, &busy);
+		asset_bench.httpd_cycles = httpd - asset_bench.httpd_cycles;
+		asset_bench.busy_cycles = busy - asset_bench.busy_cycles;
+		asset_bench.end = k_uptime_get();
+	}
+
+	k_spin_unlock(&asset_bench_lock, key);
+}
+
+static K_TIMER_DEFINE(asset_bench_timer, asset_bench_sample, NULL);
+
+static void asset_bench_open(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&asset_bench_lock);
+
+	/* Handlers run on the HTTP server thread */
+	asset_bench.httpd = k_current_get();
+	asset_bench_cycles(&asset_bench.httpd_cycles, &asset_bench.busy_cycles);
+	asset_bench.tx_pkt_min_free = SIZE_MAX;
+	asset_bench.tx_buf_min_free = SIZE_MAX;
+	asset_bench.start = k_uptime_get();
+	asset_bench.end = 0;
+	k_timer_start(&asset_bench_timer, K_MSEC(1), K_MSEC(1));
+
+	k_spin_unlock(&asset_bench_lock, key);
+}
+
+static const char *asset_bench_path(void)
+{
+	if (IS_ENABLED(CONFIG_APP_ASSET_FS)) {
+		/* Uploaded assets are read from LittleFS, others from flash */
+		return "littlefs";
+	}
+
+	return IS_ENABLED(CONFIG_WEBSERVER_ASSETS_FLASH_STREAM) ? "flash_stream"
+								: "static";
+}
+
+static int asset_bench_json(char *buf, size_t buf_len)
+{
+	struct k_mem_slab *rx_pkts, *tx_pkts;
+	struct net_buf_pool *rx_bufs, *tx_bufs;
+	struct asset_bench snapshot;
+	uint64_t httpd, busy;
+	k_spinlock_key_t key;
+	size_t tx_pkt_count, tx_buf_count;
+	bool running;
+	int written;
+
+	net_pkt_get_info(&rx_pkts, &tx_pkts, &rx_bufs, &tx_bufs);
+	tx_pkt_count = tx_pkts->info.num_blocks;
+	tx_buf_count = tx_bufs->buf_count;
+
+	key = k_spin_lock(&asset_bench_lock);
+	snapshot = asset_bench;
+	k_spin_unlock(&asset_bench_lock, key);
+
+	if (snapshot.start == 0) {
+		written = snprintf(buf, buf_len, "{\"state\":\"idle\"}");
+		return (written < 0 || written >= buf_len) ? -ENOMEM : written;
+	}
+
+	/* Still running: report the cycles counted so far */
+	running = (snapshot.end == 0);
+	if (running) {
+		asset_bench_cycles(&httpd, &busy);
+		snapshot.httpd_cycles = httpd - snapshot.httpd_cycles;
+		snapshot.busy_cycles = busy - snapshot.busy_cycles;
+		snapshot.end = k_uptime_get();
+	}
+
+	if (snapshot.tx_pkt_min_free == SIZE_MAX) {
+		snapshot.tx_pkt_min_free = tx_pkt_count;
+		snapshot.tx_buf_min_free = tx_buf_count;
+	}
+
+	written = snprintf(
+		buf, buf_len,
+		"{\"state\":\"%s\",\"path\":\"%s\",\"window_ms\":%lld,"
+		"\"cycles_per_sec\":%u,\"httpd_cycles\":%llu,"
+		"\"busy_cycles\":%llu,"
+		"\"tx_pkts\":{\"count\":%u,\"peak_used\":%u},"
+		"\"tx_bufs\":{\"count\":%u,\"peak_used\":%u}}",
+		running ? "running" : "done",
+		asset_bench_path(),
+		(long long)(snapshot.end - snapshot.start),
+		sys_clock_hw_cycles_per_sec(),
+		(unsigned long long)snapshot.httpd_cycles,
+		(unsigned long long)snapshot.busy_cycles,
+		(unsigned int)tx_pkt_count,
+		(unsigned int)(tx_pkt_count - snapshot.tx_pkt_min_free),
+		(unsigned int)tx_buf_count,
+		(unsigned int)(tx_buf_count - snapshot.tx_buf_min_free));
+	if (written < 0 || written >= buf_len) {
+		return -ENOMEM;
+	}
+
+	return written;
+}
+
+static const struct json_snapshot asset_bench_snapshot = {
+	.serialize = asset_bench_json,
+};
+
+static int asset_bench_handler(struct http_client_ctx *client,
+			       enum http_data_status status,
+			       const struct http_request_ctx *request_ctx,
+			       struct http_response_ctx *response_ctx,
+			       void *user_data)
+{
+	ARG_UNUSED(request_ctx);
+
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	if (client->method == HTTP_POST) {
+		asset_bench_open();
+	}
+
+	return json_snapshot_send(response_ctx, user_data);
+}
+
+static struct http_resource_detail_dynamic asset_bench_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = asset_bench_handler,
+	.holder = NULL,
+	.user_data = (void *)&asset_bench_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(asset_bench_api_resource, webserver_service,
+		     "/api/sys/assets", &asset_bench_api_detail);
+#endif /* CONFIG_WEBSERVER_ASSET_BENCH */
+
+#if defined(CONFIG_WEBSERVER_MICROBENCH)
+/* POST /api/sys/microbench?iterations=N - Time the serializers and parsers
+ * GET /api/sys/microbench - Results of the last run
+ */
+struct microbench_case {
+	const char *name;
+	/* One call, returns the bytes produced or consumed */
+	int (*run)(void);
+	uint32_t baseline_cycles;
+	uint32_t cycles;
+	uint32_t bytes;
+	size_t stack_used;
+	int err;
+};
+
+#define MICROBENCH_REGRESSION_PCT CONFIG_WEBSERVER_MICROBENCH_REGRESSION_PCT
+
+static char microbench_buf[512];
+static char microbench_body[48];
+static size_t microbench_body_len;
+static char microbench_reject_body[48];
+static size_t microbench_reject_body_len;
+static uint32_t microbench_iterations;
+
+static struct k_thread microbench_thread;
+static K_THREAD_STACK_DEFINE(microbench_stack,
+			     CONFIG_WEBSERVER_MICROBENCH_STACK_SIZE);
+
+static int microbench_button_json(void)
+{
+	return button_states_json(microbench_buf, sizeof(microbench_buf));
+}
+
+static int microbench_led_json(void)
+{
+	return led_api_states_json(microbench_buf, sizeof(microbench_buf));
+}
+
+/* The body is tokenized in place, so every call parses a fresh copy */
+static int microbench_led_parse(void)
+{
+	struct led_msg msg;
+	int ret;
+
+	memcpy(microbench_buf, microbench_body, microbench_body_len);
+	ret = api_json_led_cmd_parse(microbench_buf, microbench_body_len,
+				     NUM_LEDS, &msg);
+
+	return (ret < 0) ? ret : (int)microbench_body_len;
+}
+
+/* The POST /api/led request path below admission control, so a busy
+ * server does not turn the case into a 503. The command sets the last LED
+ * to the state it is already in: it is published and runs the LED state
+ * machine, but nothing is switched. Queued commands are published here as
+ * well, so the queue never fills and both configurations measure the
+ * whole command.
+ */
+static int microbench_led_post(void)
+{
+	struct http_request_ctx request = {
+		.data = (uint8_t *)microbench_buf,
+		.data_len = microbench_body_len,
+	};
+	struct http_response_ctx response = {0};
+
+	memcpy(microbench_buf, microbench_body, microbench_body_len);
+	led_api_cmd_process(&request, &response);
+	led_api_cmd_flush();
+
+	return (response.status == HTTP_200_OK ||
+		response.status == HTTP_202_ACCEPTED)
+		       ? (int)microbench_body_len
+		       : -EIO;
+}
+
+/* The same path for an out-of-range LED, rejected after validation. The
+ * rate-limited warning is suppressed after the first call.
+ */
+static int microbench_led_post_reject(void)
+{
+	struct http_request_ctx request = {
+		.data = (uint8_t *)microbench_buf,
+		.data_len = microbench_reject_body_len,
+	};
+	struct http_response_ctx response = {0};
+
+	memcpy(microbench_buf, microbench_reject_body,
+	       microbench_reject_body_len);
+	led_api_cmd_process(&request, &response);
+
+	return (response.status == HTTP_400_BAD_REQUEST)
+		       ? (int)microbench_reject_body_len
+		       : -EIO;
+}
+
+static struct microbench_case microbench_cases[] = {
+	{.name = "button_json",
+	 .run = microbench_button_json,
+	 .baseline_cycles = MICROBENCH_BASELINE_BUTTON_JSON},
+	{.name = "led_json",
+	 .run = microbench_led_json,
+	 .baseline_cycles = MICROBENCH_BASELINE_LED_JSON},
+	{.name = "led_parse",
+	 .run = microbench_led_parse,
+	 .baseline_cycles = MICROBENCH_BASELINE_LED_PARSE},
+	{.name = "led_post",
+	 .run = microbench_led_post,
+	 .baseline_cycles = MICROBENCH_BASELINE_LED_POST},
+	{.name = "led_post_reject",
+	 .run = microbench_led_post_reject,
+	 .baseline_cycles = MICROBENCH_BASELINE_LED_POST_REJECT},
+};
+
+static void microbench_thread_fn(void *p1, void *p2, void *p3)
+{
+	struct microbench_case *bench = p1;
+	timing_t start, end;
+	int ret = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < microbench_iterations && ret >= 0; i++) {
+		ret = bench->run();
+	}
+	end = timing_counter_get();
+
+	bench->err = MIN(ret, 0);
+	bench->bytes = MAX(ret, 0);
+	bench->cycles = (uint32_t)(timing_cycles_get(&start, &end) /
+				   microbench_iterations);
+}
+
+/* Each case runs on a fresh thread so its stack high-water mark is its own.
+ * The thread has the caller's priority; anything of higher priority that
+ * runs during the loop is included in the result.
+ */
+static void microbench_run(uint32_t iterations)
+{
+	const size_t stack_size = K_THREAD_STACK_SIZEOF(microbench_stack);
+	size_t unused;
+	bool is_on = false;
+
+	/* Set the last LED to the state it is in */
+	led_get_state(NUM_LEDS - 1, &is_on);
+
+	microbench_iterations = iterations;
+	microbench_body_len = snprintf(microbench_body, sizeof(microbench_body),
+				       "{\"led\":%u,\"action\":\"%s\"}",
+				       NUM_LEDS - 1, is_on ? "on" : "off");
+	microbench_reject_body_len = snprintf(
+		microbench_reject_body, sizeof(microbench_reject_body),
+		"{\"led\":%u,\"action\":\"off\"}", NUM_LEDS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(microbench_cases); i++) {
+		struct microbench_case *bench = &microbench_cases[i];
+		k_tid_t tid;
+
+		tid = k_thread_create(&microbench_thread, microbench_stack,
+				      stack_size, microbench_thread_fn, bench,
+				      NULL, NULL,
+				      k_thread_priority_get(k_current_get()),
+				      0, K_NO_WAIT);
+		k_thread_join(tid, K_FOREVER);
+
+		bench->stack_used = 0;
+		if (k_thread_stack_space_get(tid, &unused) == 0) {
+			bench->stack_used = stack_size - unused;
+		}
+
+		if (bench->baseline_cycles != 0 &&
+		    (uint64_t)bench->cycles * 100 >
+			    (uint64_t)bench->baseline_cycles *
+				    (100 + MICROBENCH_REGRESSION_PCT)) {
+			LOG_WRN("Microbench %s: %u cycles, baseline %u",
+				bench->name, bench->cycles,
+				bench->baseline_cycles);
+		}
+	}
+}
+
+#if defined(CONFIG_WEBSERVER_WORKQ)
+/* Runs are handed to the work queue, the POST returns at once */
+static uint32_t microbench_requested;
+static atomic_t microbench_busy;
+
+static void microbench_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	microbench_run(microbench_requested);
+	atomic_clear(&microbench_busy);
+}
+
+static K_WORK_DEFINE(microbench_work, microbench_work_fn);
+#endif /* CONFIG_WEBSERVER_WORKQ */
+
+static int microbench_json(char *buf, size_t buf_len)
+{
+	int offset;
+	int written;
+
+#if defined(CONFIG_WEBSERVER_WORKQ)
+	if (atomic_get(&microbench_busy)) {
+		written = snprintf(buf, buf_len, "{\"state\":\"running\"}");
+		return (written < 0 || written >= buf_len) ? -ENOMEM : written;
+	}
+#endif
+
+	if (microbench_iterations == 0) {
+		written = snprintf(buf, buf_len, "{\"state\":\"idle\"}");
+		return (written < 0 || written >= buf_len) ? -ENOMEM : written;
+	}
+
+	offset = snprintf(buf, buf_len,
+			  "{\"iterations\":%u,\"timer_mhz\":%u,"
+			  "\"stack_size\":%u,\"cases\":[",
+			  microbench_iterations, timing_freq_get_mhz(),
+			  (unsigned int)K_THREAD_STACK_SIZEOF(microbench_stack));
+	if (offset < 0 || offset >= buf_len) {
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(microbench_cases); i++) {
+		const struct microbench_case *bench = &microbench_cases[i];
+		const uint32_t ns = (uint32_t)timing_cycles_to_ns(bench->cycles);
+		char delta[12] = "null";
+
+		if (bench->baseline_cycles != 0) {
+			snprintf(delta, sizeof(delta), "%d",
+				 (int)(((int64_t)bench->cycles -
+					bench->baseline_cycles) *
+				       100 / bench->baseline_cycles));
+		}
+
+		written = snprintf(
+			buf + offset, buf_len - offset,
+			"%s{\"name\":\"%s\",\"cycles\":%u,\"ns\":%u,"
+			"\"bytes\":%u,\"bytes_per_s\":%u,\"stack_used\":%u,"
+			"\"baseline_cycles\":%u,\"delta_pct\":%s,\"err\":%d}",
+			i == 0 ? "" : ",", bench->name, bench->cycles, ns,
+			bench->bytes,
+			ns ? (uint32_t)((uint64_t)bench->bytes *
+					NSEC_PER_SEC / ns)
+			   : 0,
+			(unsigned int)bench->stack_used,
+			bench->baseline_cycles, delta, bench->err);
+		if (written < 0 || written >= buf_len - offset) {
+			return -ENOMEM;
+		}
+		offset += written;
+	}
+
+	written = snprintf(buf + offset, buf_len - offset, "]}");
+	if (written < 0 || written >= buf_len - offset) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+static const struct json_snapshot microbench_snapshot = {
+	.serialize = microbench_json,
+};
+
+static int microbench_handler(struct http_client_ctx *client,
+			      enum http_data_status status,
+			      const struct http_request_ctx *request_ctx,
+			      struct http_response_ctx *response_ctx,
+			      void *user_data)
+{
+	ARG_UNUSED(request_ctx);
+
+	/* Benchmarks can wait until buffers and heap recover */
+	if (status != HTTP_SERVER_DATA_FINAL ||
+	    !admission_check(response_ctx)) {
+		return 0;
+	}
+
+	if (client->method == HTTP_POST) {
+		uint32_t iterations = CONFIG_WEBSERVER_MICROBENCH_ITERATIONS;
+		char value[8];
+
+		if (query_param_get(client, "iterations", value,
+				    sizeof(value)) > 0) {
+			iterations = strtoul(value, NULL, 10);
+		}
+
+		if (iterations == 0 ||
+		    iterations > CONFIG_WEBSERVER_MICROBENCH_MAX_ITERATIONS) {
+			response_ctx->status = HTTP_400_BAD_REQUEST;
+			response_ctx->final_chunk = true;
+			return 0;
+		}
+
+#if defined(CONFIG_WEBSERVER_WORKQ)
+		if (atomic_set(&microbench_busy, 1)) {
+			response_ctx->status = HTTP_409_CONFLICT;
+			response_ctx->final_chunk = true;
+			return 0;
+		}
+
+		microbench_requested = iterations;
+		k_work_submit_to_queue(&webserver_workq, &microbench_work);
+#else
+		microbench_run(iterations);
+#endif
+	}
+
+	return json_snapshot_send(response_ctx, user_data);
+}
+
+static struct http_resource_detail_dynamic microbench_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = microbench_handler,
+	.holder = NULL,
+	.user_data = (void *)&microbench_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(microbench_api_resource, webserver_service,
+		     "/api/sys/microbench", &microbench_api_detail);
+#endif /* CONFIG_WEBSERVER_MICROBENCH */
+
+#if defined(CONFIG_APP_THREAD_TELEMETRY)
+/* GET /api/sys/threads - Per-thread CPU share and stack headroom */
+static struct json_stream thread_stream = {
+	.produce = thread_telemetry_json_chunk,
 };
 
-struct http_resource_detail_static index_html_resource_detail = {
+static struct http_resource_detail_dynamic thread_api_detail = {
 	/* clang-format off */
 	.common = {
-			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
 			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
-			.content_encoding = "gzip",
-			.content_type = "text/html",
+			.content_type = "application/json",
 		},
 	/* clang-format on */
-	.static_data = index_html_gz,
-	.static_data_len = sizeof(index_html_gz),
+	.cb = json_stream_handler,
+	.holder = NULL,
+	.user_data = &thread_stream,
 };
 
-HTTP_RESOURCE_DEFINE(index_html_resource, webserver_service, "/",
-		     &index_html_resource_detail);
+HTTP_RESOURCE_DEFINE(thread_api_resource, webserver_service,
+		     "/api/sys/threads", &thread_api_detail);
+#endif /* CONFIG_APP_THREAD_TELEMETRY */
 
-/* Main JS */
-static const uint8_t main_js_gz[] = {
-#include "main.js.gz.inc"
+#if defined(CONFIG_APP_LATENCY_TRACE)
+/* GET /api/sys/latency - Per-stage LED command and button latency */
+static struct json_stream latency_stream = {
+	.produce = latency_trace_json_chunk,
 };
 
-struct http_resource_detail_static main_js_resource_detail = {
+static struct http_resource_detail_dynamic latency_api_detail = {
 	/* clang-format off */
 	.common = {
-			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
 			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
-			.content_encoding = "gzip",
-			.content_type = "application/javascript",
+			.content_type = "application/json",
 		},
 	/* clang-format on */
-	.static_data = main_js_gz,
-	.static_data_len = sizeof(main_js_gz),
+	.cb = json_stream_handler,
+	.holder = NULL,
+	.user_data = &latency_stream,
 };
 
-HTTP_RESOURCE_DEFINE(main_js_resource, webserver_service, "/main.js",
-		     &main_js_resource_detail);
+HTTP_RESOURCE_DEFINE(latency_api_resource, webserver_service,
+		     "/api/sys/latency", &latency_api_detail);
+#endif /* CONFIG_APP_LATENCY_TRACE */
 
-/* Styles CSS */
-static const uint8_t styles_css_gz[] = {
-#include "styles.css.gz.inc"
+#if defined(CONFIG_APP_ZBUS_STATS)
+/* GET /api/sys/zbus - Channel publish and listener run time statistics */
+static struct json_stream zbus_stream = {
+	.produce = zbus_stats_json_chunk,
 };
 
-struct http_resource_detail_static styles_css_resource_detail = {
+static struct http_resource_detail_dynamic zbus_api_detail = {
 	/* clang-format off */
 	.common = {
-			.type = HTTP_RESOURCE_TYPE_STATIC,
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
 			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
-			.content_encoding = "gzip",
-			.content_type = "text/css",
+			.content_type = "application/json",
 		},
 	/* clang-format on */
-	.static_data = styles_css_gz,
-	.static_data_len = sizeof(styles_css_gz),
+	.cb = json_stream_handler,
+	.holder = NULL,
+	.user_data = &zbus_stream,
 };
 
-HTTP_RESOURCE_DEFINE(styles_css_resource, webserver_service, "/styles.css",
-		     &styles_css_resource_detail);
+HTTP_RESOURCE_DEFINE(zbus_api_resource, webserver_service, "/api/sys/zbus",
+		     &zbus_api_detail);
+#endif /* CONFIG_APP_ZBUS_STATS */
 
-/* ============================================================================
- * DYNAMIC API ENDPOINTS
- * ============================================================================
+#if defined(CONFIG_APP_LOG_RING)
+/* GET /api/logs - Log ring as text, ?since= returns only newer records.
+ * The response ends at the ring head seen by the first chunk; clients poll
+ * again with ?since= set to X-Log-Next instead of holding the server thread.
  */
+struct log_stream {
+	const struct http_client_ctx *client;
+	uint32_t pos;
+	uint32_t end;
+	bool active;
+};
 
-/* GET /api/buttons - Get button states */
-static uint8_t button_api_buf[512];
+static struct log_stream log_stream;
+static uint8_t log_api_buf[512];
+static char log_cursor_value[11];
+static char log_next_value[11];
 
-static int button_api_handler(struct http_client_ctx *client,
-			      enum http_data_status status,
-			      const struct http_request_ctx *request_ctx,
-			      struct http_response_ctx *response_ctx,
-			      void *user_data)
+static const struct http_header log_api_headers[] = {
+	{.name = "X-Log-Cursor", .value = log_cursor_value},
+	{.name = "X-Log-Next", .value = log_next_value},
+};
+
+static void log_stream_start(struct log_stream *stream,
+			     const struct http_client_ctx *client)
 {
-	ARG_UNUSED(client);
+	char value[11];
+
+	stream->client = client;
+	stream->active = true;
+	stream->pos = log_ring_tail();
+	stream->end = log_ring_head();
+
+	if (query_param_get(client, "since", value, sizeof(value)) > 0) {
+		stream->pos = strtoul(value, NULL, 10);
+	}
+}
+
+static int log_api_handler(struct http_client_ctx *client,
+			   enum http_data_status status,
+			   const struct http_request_ctx *request_ctx,
+			   struct http_response_ctx *response_ctx,
+			   void *user_data)
+{
+	struct log_stream *stream = &log_stream;
+	bool first = false;
+	size_t len = 0;
+	bool done;
+
 	ARG_UNUSED(request_ctx);
 	ARG_UNUSED(user_data);
 
-	if (status != HTTP_SERVER_DATA_FINAL) {
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		stream->active = false;
 		return 0;
 	}
 
-	int offset = 0;
-	int remaining = sizeof(button_api_buf);
-	int written = snprintf((char *)button_api_buf + offset, remaining,
-			       "{\"buttons\":[");
-	if (written < 0 || written >= remaining) {
-		return -ENOMEM;
+	if (status != HTTP_SERVER_DATA_FINAL) {
+		return 0;
 	}
-	offset += written;
-	remaining -= written;
 
-	for (int i = 0; i < NUM_BUTTONS; i++) {
-		const bool is_last = (i == NUM_BUTTONS - 1);
-		const uint8_t button_number = button_states[i].button_number;
-		const char *button_name = app_button_label(button_number);
-
-		written = snprintf(
-			(char *)button_api_buf + offset, remaining,
-			/* clang-format off */
-			"{\"number\":%u,\"name\":\"%s\",\"pressed\":%s, \"count\":%u}%s",
-			/* clang-format on */
-			button_number, button_name ? button_name : "",
-			button_states[i].is_pressed ? "true" : "false",
-			button_states[i].press_count, is_last ? "" : ",");
-		if (written < 0 || written >= remaining) {
-			return -ENOMEM;
+	if (!stream->active || stream->client != client) {
+		if (!admission_check(response_ctx)) {
+			stream->active = false;
+			return 0;
 		}
-		offset += written;
-		remaining -= written;
+
+		log_stream_start(stream, client);
+		first = true;
 	}
 
-	written = snprintf((char *)button_api_buf + offset, remaining, "]}");
-	if (written < 0 || written >= remaining) {
-		return -ENOMEM;
+	if (stream->pos < stream->end) {
+		len = log_ring_read(&stream->pos, (char *)log_api_buf,
+				    MIN(sizeof(log_api_buf),
+					stream->end - stream->pos));
+	}
+	done = (stream->pos >= stream->end) || (len == 0);
+
+	if (first) {
+		snprintf(log_cursor_value, sizeof(log_cursor_value), "%u",
+			 stream->pos - len);
+		snprintf(log_next_value, sizeof(log_next_value), "%u",
+			 stream->end);
+		response_ctx->headers = log_api_headers;
+		response_ctx->header_count = ARRAY_SIZE(log_api_headers);
 	}
-	offset += written;
 
-	response_ctx->body = button_api_buf;
-	response_ctx->body_len = offset;
-	response_ctx->final_chunk = true;
+	if (done) {
+		stream->active = false;
+	}
+
+	response_ctx->body = log_api_buf;
+	response_ctx->body_len = len;
+	response_ctx->final_chunk = done;
 	response_ctx->status = HTTP_200_OK;
 
 	return 0;
 }
 
-static struct http_resource_detail_dynamic button_api_detail = {
+static struct http_resource_detail_dynamic log_api_detail = {
 	/* clang-format off */
 	.common = {
 			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
 			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
-			.content_type = "application/json",
+			.content_type = "text/plain",
 		},
 	/* clang-format on */
-	.cb = button_api_handler,
+	.cb = log_api_handler,
 	.holder = NULL,
 	.user_data = NULL,
 };
 
-HTTP_RESOURCE_DEFINE(button_api_resource, webserver_service, "/api/buttons",
-		     &button_api_detail);
+HTTP_RESOURCE_DEFINE(log_api_resource, webserver_service, "/api/logs",
+		     &log_api_detail);
+#endif /* CONFIG_APP_LOG_RING */
 
-/* GET /api/leds - Get LED states */
-static uint8_t led_get_api_buf[512];
+/* ============================================================================
+ * THROUGHPUT BENCHMARK
+ * ============================================================================
+ */
 
-static int led_get_api_handler(struct http_client_ctx *client,
-			       enum http_data_status status,
-			       const struct http_request_ctx *request_ctx,
-			       struct http_response_ctx *response_ctx,
-			       void *user_data)
+#if defined(CONFIG_WEBSERVER_BENCH)
+/* GET /api/bench/download?bytes=N - Stream N bytes of filler
+ * POST /api/bench/upload - Count and discard the request body
+ * GET /api/bench - Server-side timing of the last transfer of each kind
+ *
+ * Download chunks all point at the same pattern buffer, so the figures
+ * measure the network stack rather than data generation.
+ */
+struct bench_transfer {
+	const struct http_client_ctx *client;
+	uint32_t bytes;
+	uint32_t remaining;
+	int64_t start;
+	bool active;
+};
+
+struct bench_result {
+	uint32_t bytes;
+	uint32_t duration_us;
+	uint32_t count;
+	uint32_t aborted;
+};
+
+static uint8_t bench_pattern[CONFIG_WEBSERVER_BENCH_CHUNK_SIZE];
+static struct bench_transfer bench_download;
+static struct bench_transfer bench_upload;
+static struct bench_result bench_download_result;
+static struct bench_result bench_upload_result;
+
+static char bench_bytes_value[11];
+static char bench_duration_value[11];
+static char bench_rate_value[11];
+
+static const struct http_header bench_download_headers[] = {
+	{.name = "X-Bench-Bytes", .value = bench_bytes_value},
+	{.name = "X-Bench-Chunk-Size",
+	 .value = STRINGIFY(CONFIG_WEBSERVER_BENCH_CHUNK_SIZE)},
+};
+
+static const struct http_header bench_upload_headers[] = {
+	{.name = "X-Bench-Bytes", .value = bench_bytes_value},
+	{.name = "X-Bench-Duration-Us", .value = bench_duration_value},
+	{.name = "X-Bench-Rate-Kbps", .value = bench_rate_value},
+};
+
+static uint32_t bench_rate_kbps(uint32_t bytes, uint32_t duration_us)
 {
-	ARG_UNUSED(client);
+	return duration_us ? (uint32_t)((uint64_t)bytes * 8000U / duration_us)
+			   : 0;
+}
+
+static void bench_start(struct bench_transfer *transfer,
+			const struct http_client_ctx *client, uint32_t bytes)
+{
+	transfer->client = client;
+	transfer->bytes = 0;
+	transfer->remaining = bytes;
+	transfer->start = k_uptime_ticks();
+	transfer->active = true;
+}
+
+static void bench_finish(struct bench_transfer *transfer,
+			 struct bench_result *result)
+{
+	result->bytes = transfer->bytes;
+	result->duration_us =
+		(uint32_t)k_ticks_to_us_floor64(k_uptime_ticks() -
+						transfer->start);
+	result->count++;
+	transfer->active = false;
+}
+
+static int bench_download_handler(struct http_client_ctx *client,
+				  enum http_data_status status,
+				  const struct http_request_ctx *request_ctx,
+				  struct http_response_ctx *response_ctx,
+				  void *user_data)
+{
+	struct bench_transfer *transfer = &bench_download;
+	char value[11];
+	size_t len;
+
 	ARG_UNUSED(request_ctx);
 	ARG_UNUSED(user_data);
 
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		if (transfer->active && transfer->client == client) {
+			transfer->active = false;
+			bench_download_result.aborted++;
+		}
+		return 0;
+	}
+
 	if (status != HTTP_SERVER_DATA_FINAL) {
 		return 0;
 	}
 
-	/* Get LED states */
-	int written = led_get_all_states_json((char *)led_get_api_buf,
-					      sizeof(led_get_api_buf));
+	if (!transfer->active || transfer->client != client) {
+		unsigned long bytes;
+		char *end;
 
-	if (written > 0) {
-		response_ctx->body = led_get_api_buf;
-		response_ctx->body_len = written;
-		response_ctx->final_chunk = true;
-		response_ctx->status = HTTP_200_OK;
+		/* Every chunk holds TX buffers, so a transfer starts only
+		 * when there are enough of them
+		 */
+		if (!admission_check(response_ctx)) {
+			return 0;
+		}
+
+		if (query_param_get(client, "bytes", value, sizeof(value)) < 0) {
+			response_ctx->status = HTTP_400_BAD_REQUEST;
+			response_ctx->final_chunk = true;
+			return 0;
+		}
+
+		bytes = strtoul(value, &end, 10);
+		if (*end != '\0' || bytes > CONFIG_WEBSERVER_BENCH_MAX_BYTES) {
+			response_ctx->status = HTTP_400_BAD_REQUEST;
+			response_ctx->final_chunk = true;
+			return 0;
+		}
+
+		bench_start(transfer, client, bytes);
+		snprintf(bench_bytes_value, sizeof(bench_bytes_value), "%lu",
+			 bytes);
+		response_ctx->headers = bench_download_headers;
+		response_ctx->header_count = ARRAY_SIZE(bench_download_headers);
 	}
 
+	len = MIN(transfer->remaining, sizeof(bench_pattern));
+	transfer->remaining -= len;
+	transfer->bytes += len;
+
+	/* Timed until the last chunk is handed to the stack */
+	if (transfer->remaining == 0) {
+		bench_finish(transfer, &bench_download_result);
+	}
+
+	response_ctx->body = bench_pattern;
+	response_ctx->body_len = len;
+	response_ctx->final_chunk = (transfer->remaining == 0);
+	response_ctx->status = HTTP_200_OK;
+
 	return 0;
 }
 
-static struct http_resource_detail_dynamic led_get_api_detail = {
+static struct http_resource_detail_dynamic bench_download_detail = {
 	/* clang-format off */
 	.common = {
 			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
 			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
-			.content_type = "application/json",
+			.content_type = "application/octet-stream",
 		},
 	/* clang-format on */
-	.cb = led_get_api_handler,
+	.cb = bench_download_handler,
 	.holder = NULL,
 	.user_data = NULL,
 };
 
-HTTP_RESOURCE_DEFINE(led_get_api_resource, webserver_service, "/api/leds",
-		     &led_get_api_detail);
-
-/* POST /api/led - Control LED */
-struct led_control_cmd {
-	uint8_t led;
-	char action[8]; /* "on", "off", "toggle" */
-};
-
-static const struct json_obj_descr led_control_descr[] = {
-	JSON_OBJ_DESCR_PRIM(struct led_control_cmd, led, JSON_TOK_NUMBER),
-	JSON_OBJ_DESCR_PRIM(struct led_control_cmd, action,
-			    JSON_TOK_STRING_BUF),
-};
+HTTP_RESOURCE_DEFINE(bench_download_resource, webserver_service,
+		     "/api/bench/download", &bench_download_detail);
 
-static int led_post_api_handler(struct http_client_ctx *client,
+static int bench_upload_handler(struct http_client_ctx *client,
 				enum http_data_status status,
 				const struct http_request_ctx *request_ctx,
 				struct http_response_ctx *response_ctx,
 				void *user_data)
 {
-	ARG_UNUSED(client);
+	struct bench_transfer *transfer = &bench_upload;
+	const struct bench_result *result = &bench_upload_result;
+	int written;
+
 	ARG_UNUSED(user_data);
 
-	if (status != HTTP_SERVER_DATA_FINAL) {
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		if (transfer->active && transfer->client == client) {
+			transfer->active = false;
+			bench_upload_result.aborted++;
+		}
 		return 0;
 	}
 
-	if (request_ctx->data == NULL || request_ctx->data_len == 0) {
-		response_ctx->status = HTTP_400_BAD_REQUEST;
-		response_ctx->final_chunk = true;
+	/* Timed from the first body chunk handed to the handler */
+	if (!transfer->active || transfer->client != client) {
+		bench_start(transfer, client, 0);
+	}
+
+	transfer->bytes += request_ctx->data_len;
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
 		return 0;
 	}
 
-	struct led_control_cmd cmd;
-	memset(&cmd, 0, sizeof(cmd));
-	int ret = json_obj_parse((char *)request_ctx->data,
-				 request_ctx->data_len, led_control_descr,
-				 ARRAY_SIZE(led_control_descr), &cmd);
+	bench_finish(transfer, &bench_upload_result);
 
-	if (ret < 0) {
-		LOG_WRN("Failed to parse LED command: %d", ret);
-		response_ctx->status = HTTP_400_BAD_REQUEST;
-		response_ctx->final_chunk = true;
+	snprintf(bench_bytes_value, sizeof(bench_bytes_value), "%u",
+		 result->bytes);
+	snprintf(bench_duration_value, sizeof(bench_duration_value), "%u",
+		 result->duration_us);
+	snprintf(bench_rate_value, sizeof(bench_rate_value), "%u",
+		 bench_rate_kbps(result->bytes, result->duration_us));
+
+	written = snprintf((char *)json_snapshot_buf, sizeof(json_snapshot_buf),
+			   "{\"bytes\":%u,\"duration_us\":%u}", result->bytes,
+			   result->duration_us);
+
+	response_ctx->headers = bench_upload_headers;
+	response_ctx->header_count = ARRAY_SIZE(bench_upload_headers);
+	response_ctx->body = json_snapshot_buf;
+	response_ctx->body_len = written;
+	response_ctx->final_chunk = true;
+	response_ctx->status = HTTP_200_OK;
+
+	return 0;
+}
+
+static struct http_resource_detail_dynamic bench_upload_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_POST),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = bench_upload_handler,
+	.holder = NULL,
+	.user_data = NULL,
+};
+
+HTTP_RESOURCE_DEFINE(bench_upload_resource, webserver_service,
+		     "/api/bench/upload", &bench_upload_detail);
+
+static int bench_result_json(char *buf, size_t buf_len,
+			     const struct bench_result *result)
+{
+	return snprintf(buf, buf_len,
+			"{\"count\":%u,\"aborted\":%u,\"bytes\":%u,"
+			"\"duration_us\":%u,\"rate_kbps\":%u}",
+			result->count, result->aborted, result->bytes,
+			result->duration_us,
+			bench_rate_kbps(result->bytes, result->duration_us));
+}
+
+static int bench_json(char *buf, size_t buf_len)
+{
+	int offset = 0;
+	int written;
+
+	written = snprintf(buf, buf_len, "{\"download\":");
+	if (written < 0 || written >= buf_len) {
+		return -ENOMEM;
+	}
+	offset += written;
+
+	written = bench_result_json(buf + offset, buf_len - offset,
+				    &bench_download_result);
+	if (written < 0 || written >= buf_len - offset) {
+		return -ENOMEM;
+	}
+	offset += written;
+
+	written = snprintf(buf + offset, buf_len - offset, ",\"upload\":");
+	if (written < 0 || written >= buf_len - offset) {
+		return -ENOMEM;
+	}
+	offset += written;
+
+	written = bench_result_json(buf + offset, buf_len - offset,
+				    &bench_upload_result);
+	if (written < 0 || written >= buf_len - offset) {
+		return -ENOMEM;
+	}
+	offset += written;
+
+	written = snprintf(buf + offset, buf_len - offset, "}");
+	if (written < 0 || written >= buf_len - offset) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
+
+static const struct json_snapshot bench_api_snapshot = {
+	.serialize = bench_json,
+};
+
+static struct http_resource_detail_dynamic bench_api_detail = {
+	/* clang-format off */
+	.common = {
+			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
+			.bitmask_of_supported_http_methods = BIT(HTTP_GET),
+			.content_type = "application/json",
+		},
+	/* clang-format on */
+	.cb = json_snapshot_handler,
+	.holder = NULL,
+	.user_data = (void *)&bench_api_snapshot,
+};
+
+HTTP_RESOURCE_DEFINE(bench_api_resource, webserver_service, "/api/bench",
+		     &bench_api_detail);
+#endif /* CONFIG_WEBSERVER_BENCH */
+
+#if defined(CONFIG_APP_ZPERF)
+/* GET /api/bench/zperf - zperf state and retained results
+ * POST /api/bench/zperf - Start or stop a session, e.g.
+ *   {"action":"start","mode":"upload","proto":"udp","host":"192.168.7.2",
+ *    "port":5001,"duration_ms":10000,"rate_kbps":20000,"packet_size":1024}
+ */
+struct zperf_cmd {
+	char action[8];
+	char mode[9];
+	char proto[4];
+	char host[NET_IPV4_ADDR_LEN];
+	int32_t port;
+	int32_t duration_ms;
+	int32_t rate_kbps;
+	int32_t packet_size;
+};
+
+static const struct json_obj_descr zperf_cmd_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, action, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, mode, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, proto, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, host, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, port, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, duration_ms, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, rate_kbps, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct zperf_cmd, packet_size, JSON_TOK_NUMBER),
+};
+
+static const struct json_snapshot zperf_api_snapshot = {
+	.serialize = zperf_service_json,
+};
+
+static int zperf_cmd_params(const struct zperf_cmd *cmd,
+			    struct zperf_service_params *params)
+{
+	memset(params, 0, sizeof(*params));
+
+	if (strcmp(cmd->proto, "tcp") == 0) {
+		params->tcp = true;
+	} else if (cmd->proto[0] != '\0' && strcmp(cmd->proto, "udp") != 0) {
+		return -EINVAL;
+	}
+
+	if (strcmp(cmd->mode, "upload") == 0) {
+		params->upload = true;
+	} else if (cmd->mode[0] != '\0' &&
+		   strcmp(cmd->mode, "download") != 0) {
+		return -EINVAL;
+	}
+
+	if (cmd->port < 0 || cmd->port > UINT16_MAX || cmd->duration_ms < 0 ||
+	    cmd->rate_kbps < 0 || cmd->packet_size < 0 ||
+	    cmd->packet_size > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	params->port = cmd->port ? cmd->port : CONFIG_APP_ZPERF_DEFAULT_PORT;
+	params->duration_ms = cmd->duration_ms ? cmd->duration_ms : 10000;
+	params->rate_kbps = cmd->rate_kbps ? cmd->rate_kbps
+					   : CONFIG_APP_ZPERF_DEFAULT_RATE_KBPS;
+	params->packet_size = cmd->packet_size
+				      ? cmd->packet_size
+				      : CONFIG_APP_ZPERF_DEFAULT_PACKET_SIZE;
+
+	if (params->upload &&
+	    zsock_inet_pton(AF_INET, cmd->host, &params->peer) != 1) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Room for every field of struct zperf_cmd at its longest */
+static char zperf_body[256];
+static size_t zperf_body_len;
+static bool zperf_body_overflow;
+static const struct http_client_ctx *zperf_client;
+
+static int zperf_api_handler(struct http_client_ctx *client,
+			     enum http_data_status status,
+			     const struct http_request_ctx *request_ctx,
+			     struct http_response_ctx *response_ctx,
+			     void *user_data)
+{
+	struct zperf_service_params params;
+	struct zperf_cmd cmd;
+	int ret = 0;
+
+	if (status == HTTP_SERVER_DATA_ABORTED) {
+		if (zperf_client == client) {
+			zperf_client = NULL;
+		}
 		return 0;
 	}
 
-	LOG_INF("LED control: LED %d, action='%s'", cmd.led, cmd.action);
+	/* The body arrives in pieces, collect it before parsing */
+	if (client->method == HTTP_POST) {
+		if (zperf_client != client) {
+			zperf_client = client;
+			zperf_body_len = 0;
+			zperf_body_overflow = false;
+		}
 
-	if (cmd.led >= NUM_LEDS) {
-		LOG_WRN("LED command out of range: %d (max: %d)", cmd.led,
-			NUM_LEDS - 1);
-		response_ctx->status = HTTP_400_BAD_REQUEST;
-		response_ctx->final_chunk = true;
+		if (request_ctx->data_len >
+		    sizeof(zperf_body) - zperf_body_len) {
+			zperf_body_overflow = true;
+		} else if (request_ctx->data_len > 0) {
+			memcpy(zperf_body + zperf_body_len, request_ctx->data,
+			       request_ctx->data_len);
+			zperf_body_len += request_ctx->data_len;
+		}
+	}
+
+	if (status != HTTP_SERVER_DATA_FINAL) {
 		return 0;
 	}
 
-	/* Publish LED command via Zbus */
-	struct led_msg msg;
-	msg.led_number = cmd.led;
-
-	if (strcmp(cmd.action, "on") == 0) {
-		msg.type = LED_COMMAND_ON;
-	} else if (strcmp(cmd.action, "off") == 0) {
-		msg.type = LED_COMMAND_OFF;
-	} else if (strcmp(cmd.action, "toggle") == 0) {
-		msg.type = LED_COMMAND_TOGGLE;
-	} else {
-		LOG_WRN("Unknown LED action: %s", cmd.action);
-		response_ctx->status = HTTP_400_BAD_REQUEST;
-		response_ctx->final_chunk = true;
+	/* A stop frees buffers, so only a start and a GET are shed */
+	if (client->method != HTTP_POST && !admission_check(response_ctx)) {
 		return 0;
 	}
 
-	ret = zbus_chan_pub(&LED_CMD_CHAN, &msg, K_MSEC(100));
+	if (client->method == HTTP_POST) {
+		zperf_client = NULL;
+
+		if (zperf_body_overflow) {
+			response_ctx->status = HTTP_413_PAYLOAD_TOO_LARGE;
+			response_ctx->final_chunk = true;
+			return 0;
+		}
+
+		/* Only a complete, non-empty body is parsed */
+		memset(&cmd, 0, sizeof(cmd));
+		ret = (zperf_body_len == 0)
+			      ? -EINVAL
+			      : json_obj_parse(zperf_body, zperf_body_len,
+					       zperf_cmd_descr,
+					       ARRAY_SIZE(zperf_cmd_descr),
+					       &cmd);
+		if (ret < 0) {
+			ret = -EINVAL;
+		} else if (strcmp(cmd.action, "start") == 0) {
+			ret = zperf_cmd_params(&cmd, &params);
+			if (ret == 0) {
+				if (!admission_check(response_ctx)) {
+					return 0;
+				}
+				ret = zperf_service_start(&params);
+			}
+		} else if (strcmp(cmd.action, "stop") == 0) {
+			ret = zperf_service_stop();
+		} else {
+			ret = -EINVAL;
+		}
+	}
+
 	if (ret < 0) {
-		LOG_ERR("Failed to publish LED command: %d", ret);
-		response_ctx->status = HTTP_500_INTERNAL_SERVER_ERROR;
-	} else {
-		response_ctx->status = HTTP_200_OK;
+		APP_LOG_WRN_RL("zperf request failed: %d", ret);
+		response_ctx->status = (ret == -EBUSY || ret == -EALREADY)
+					       ? HTTP_409_CONFLICT
+					       : HTTP_400_BAD_REQUEST;
+		response_ctx->final_chunk = true;
+		return 0;
 	}
 
-	response_ctx->final_chunk = true;
-	return 0;
+	return json_snapshot_send(response_ctx, user_data);
 }
 
-static struct http_resource_detail_dynamic led_post_api_detail = {
+static struct http_resource_detail_dynamic zperf_api_detail = {
 	/* clang-format off */
 	.common = {
 			.type = HTTP_RESOURCE_TYPE_DYNAMIC,
-			.bitmask_of_supported_http_methods = BIT(HTTP_POST),
+			.bitmask_of_supported_http_methods =
+				BIT(HTTP_GET) | BIT(HTTP_POST),
+			.content_type = "application/json",
 		},
 	/* clang-format on */
-	.cb = led_post_api_handler,
+	.cb = zperf_api_handler,
 	.holder = NULL,
-	.user_data = NULL,
+	.user_data = (void *)&zperf_api_snapshot,
 };
 
-HTTP_RESOURCE_DEFINE(led_post_api_resource, webserver_service, "/api/led",
-		     &led_post_api_detail);
+HTTP_RESOURCE_DEFINE(zperf_api_resource, webserver_service,
+		     "/api/bench/zperf", &zperf_api_detail);
+#endif /* CONFIG_APP_ZPERF */
 
 /* ============================================================================
  * PUBLIC API
@@ -407,11 +2816,26 @@ int webserver_module_init(void)
 {
 	LOG_INF("Initializing webserver module");
 
+#if defined(CONFIG_WEBSERVER_BENCH)
+	for (size_t i = 0; i < sizeof(bench_pattern); i++) {
+		bench_pattern[i] = 'a' + (i % 26);
+	}
+#endif
+#if defined(CONFIG_WEBSERVER_MICROBENCH)
+	timing_init();
+	timing_start();
+#endif
+
+	webserver_workq_start();
+
+	state_store_load();
+
 	/* Initialize button states */
 	for (int i = 0; i < NUM_BUTTONS; i++) {
-		button_states[i].button_number = i;
-		button_states[i].is_pressed = false;
-		button_states[i].press_count = 0;
+		button_states[i].number = i;
+		button_states[i].pressed = false;
+		button_states[i].count = 0;
+		state_store_press_count_get(i, &button_states[i].count);
 	}
 
 	LOG_INF("Webserver module initialized");
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "acs.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* 2.4 GHz channels are 5 MHz apart, a 20 MHz BSS overlaps +/-4 channels */
+#define ACS_2G_OVERLAP 5
+
+/* RSSI range mapped to the signal weight */
+#define ACS_RSSI_FLOOR   -95
+#define ACS_RSSI_CEILING -30
+
+/* Stronger BSSs hurt more: weight 1 at the floor up to 66 at the ceiling */
+static uint32_t signal_weight(int8_t rssi)
+{
+	int value = rssi;
+
+	if (value < ACS_RSSI_FLOOR) {
+		value = ACS_RSSI_FLOOR;
+	} else if (value > ACS_RSSI_CEILING) {
+		value = ACS_RSSI_CEILING;
+	}
+
+	return (uint32_t)(value - ACS_RSSI_FLOOR + 1);
+}
+
+/* Fraction (in fifths) of a BSS's energy that lands on a candidate */
+static uint32_t overlap_fifths(const struct acs_channel *candidate,
+			       const struct acs_bss *bss)
+{
+	int distance;
+
+	if (candidate->band != bss->band) {
+		return 0;
+	}
+
+	distance = abs((int)candidate->channel - (int)bss->channel);
+
+	if (candidate->band == ACS_BAND_5_GHZ) {
+		return (distance == 0) ? ACS_2G_OVERLAP : 0;
+	}
+
+	return (distance < ACS_2G_OVERLAP) ? (uint32_t)(ACS_2G_OVERLAP - distance)
+					   : 0;
+}
+
+int acs_add_candidates(struct acs_ctx *ctx, enum acs_band band,
+		       const char *list, bool reset)
+{
+	int added = 0;
+	const char *p = list;
+
+	if (!ctx || !list) {
+		return -EINVAL;
+	}
+
+	if (reset) {
+		memset(ctx, 0, sizeof(*ctx));
+	}
+
+	while (*p != '\0') {
+		char *end;
+		long channel = strtol(p, &end, 10);
+
+		if (end == p) {
+			/* Skip separators */
+			p++;
+			continue;
+		}
+		p = end;
+
+		if (channel <= 0 || channel > UINT8_MAX) {
+			return -EINVAL;
+		}
+
+		if (ctx->num_channels >= ACS_MAX_CHANNELS) {
+			return -ENOMEM;
+		}
+
+		ctx->channels[ctx->num_channels].band = band;
+		ctx->channels[ctx->num_channels].channel = (uint8_t)channel;
+		ctx->num_channels++;
+		added++;
+	}
+
+	return added;
+}
+
+void acs_add_bss(struct acs_ctx *ctx, const struct acs_bss *bss)
+{
+	const uint32_t weight = signal_weight(bss->rssi);
+
+	for (size_t i = 0; i < ctx->num_channels; i++) {
+		struct acs_channel *candidate = &ctx->channels[i];
+		const uint32_t overlap = overlap_fifths(candidate, bss);
+
+		if (overlap == 0) {
+			continue;
+		}
+
+		candidate->score += overlap * weight;
+		if (candidate->channel == bss->channel) {
+			candidate->bss_count++;
+		}
+	}
+
+	ctx->bss_total++;
+}
+
+const struct acs_channel *acs_select(const struct acs_ctx *ctx)
+{
+	const struct acs_channel *best = NULL;
+
+	for (size_t i = 0; i < ctx->num_channels; i++) {
+		const struct acs_channel *candidate = &ctx->channels[i];
+
+		if (!best || candidate->score < best->score ||
+		    (candidate->score == best->score &&
+		     candidate->bss_count < best->bss_count)) {
+			best = candidate;
+		}
+	}
+
+	return best;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file acs.h
+ * @brief Automatic channel selection for the SoftAP
+ *
+ * The scoring code has no kernel or network stack dependencies. BSS
+ * reports are fed in through acs_add_bss() by a scan source, so the same
+ * scoring runs against live net_mgmt scans on target and against recorded
+ * scan results on a host build.
+ */
+
+#ifndef ACS_H
+#define ACS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ACS_MAX_CHANNELS 32
+
+/**
+ * @brief Frequency bands known to the scorer
+ */
+enum acs_band {
+	ACS_BAND_2_4_GHZ, /**< 2.4 GHz, 5 MHz channel spacing */
+	ACS_BAND_5_GHZ,   /**< 5 GHz, non-overlapping 20 MHz channels */
+};
+
+/**
+ * @brief One BSS seen during a scan
+ */
+struct acs_bss {
+	enum acs_band band;
+	uint8_t channel;
+	int8_t rssi; /**< dBm */
+};
+
+/**
+ * @brief Score of one candidate channel, lower is better
+ */
+struct acs_channel {
+	enum acs_band band;
+	uint8_t channel;
+	uint16_t bss_count; /**< BSSs on this exact channel */
+	uint32_t score;     /**< Weighted interference from all BSSs */
+};
+
+/**
+ * @brief Channel selection context
+ */
+struct acs_ctx {
+	struct acs_channel channels[ACS_MAX_CHANNELS];
+	size_t num_channels;
+	uint32_t bss_total;
+};
+
+struct acs_scan_source;
+
+/**
+ * @brief Scan completion callback
+ * @param ctx Context the results were added to
+ * @param status 0 on success, negative error code on failure
+ */
+typedef void (*acs_scan_done_cb_t)(struct acs_ctx *ctx, int status);
+
+/**
+ * @brief Provider of BSS reports
+ *
+ * start() begins a scan, feeds every result into ctx with acs_add_bss()
+ * and calls done once finished. It may complete synchronously.
+ */
+struct acs_scan_source {
+	const char *name;
+	int (*start)(struct acs_ctx *ctx, acs_scan_done_cb_t done);
+};
+
+/**
+ * @brief Reset the context and register candidate channels
+ *
+ * May be called once per band to add candidates from several bands.
+ *
+ * @param ctx Selection context
+ * @param band Band of the listed channels
+ * @param list Comma or space separated channel numbers, e.g. "1,6,11"
+ * @param reset Clear previous candidates and results first
+ * @return Number of candidates added, or negative error code
+ */
+int acs_add_candidates(struct acs_ctx *ctx, enum acs_band band,
+		       const char *list, bool reset);
+
+/**
+ * @brief Account for one BSS seen during the scan
+ * @param ctx Selection context
+ * @param bss Scan result
+ */
+void acs_add_bss(struct acs_ctx *ctx, const struct acs_bss *bss);
+
+/**
+ * @brief Pick the least congested candidate
+ *
+ * Ties are broken by the number of co-channel BSSs and then by the
+ * order in which candidates were added.
+ *
+ * @param ctx Selection context
+ * @return Selected candidate, or NULL if there are no candidates
+ */
+const struct acs_channel *acs_select(const struct acs_ctx *ctx);
+
+#endif /* ACS_H */
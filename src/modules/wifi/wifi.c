@@ -5,7 +5,16 @@
  */
 
 #include "wifi.h"
+#include "../app_trace.h"
+#include "../boot/boot_timeline.h"
+#include "../event_loop/event_loop.h"
 #include "../messages.h"
+#include "../network/network.h"
+#include "../zbus_stats/zbus_stats.h"
+
+#if defined(CONFIG_WIFI_ACS)
+#include "acs.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(wifi_module, CONFIG_WIFI_MODULE_LOG_LEVEL);
@@ -19,7 +28,9 @@ LOG_MODULE_REGISTER(wifi_module, CONFIG_WIFI_MODULE_LOG_LEVEL);
 #include <zephyr/net/socket.h>
 #include <zephyr/net/wifi_mgmt.h>
 #include <zephyr/smf.h>
+#include <zephyr/spinlock.h>
 #include <zephyr/zbus/zbus.h>
+#include <stdio.h>
 
 /* ============================================================================
  * ZBUS CHANNEL DEFINITION
@@ -36,20 +47,47 @@ ZBUS_CHAN_DEFINE(WIFI_CHAN, struct wifi_msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY,
 
 /* Forward declarations */
 static void wifi_idle_entry(void *obj);
+static void wifi_acs_entry(void *obj);
+static enum smf_state_result wifi_acs_run(void *obj);
+static void wifi_acs_exit(void *obj);
 static void wifi_starting_entry(void *obj);
 static enum smf_state_result wifi_starting_run(void *obj);
+static void wifi_starting_exit(void *obj);
 static void wifi_active_entry(void *obj);
 static enum smf_state_result wifi_active_run(void *obj);
 static void wifi_error_entry(void *obj);
+static enum smf_state_result wifi_error_run(void *obj);
+static void wifi_error_exit(void *obj);
+
+enum wifi_state {
+	WIFI_STATE_IDLE,
+	WIFI_STATE_ACS,
+	WIFI_STATE_STARTING,
+	WIFI_STATE_ACTIVE,
+	WIFI_STATE_ERROR,
+};
 
 /* State table */
 static const struct smf_state wifi_states[] = {
-	[0] = SMF_CREATE_STATE(wifi_idle_entry, NULL, NULL, NULL, NULL),
-	[1] = SMF_CREATE_STATE(wifi_starting_entry, wifi_starting_run, NULL,
-			       NULL, NULL),
-	[2] = SMF_CREATE_STATE(wifi_active_entry, wifi_active_run, NULL, NULL,
-			       NULL),
-	[3] = SMF_CREATE_STATE(wifi_error_entry, NULL, NULL, NULL, NULL),
+	[WIFI_STATE_IDLE] =
+		SMF_CREATE_STATE(wifi_idle_entry, NULL, NULL, NULL, NULL),
+	[WIFI_STATE_ACS] = SMF_CREATE_STATE(wifi_acs_entry, wifi_acs_run,
+					    wifi_acs_exit, NULL, NULL),
+	[WIFI_STATE_STARTING] =
+		SMF_CREATE_STATE(wifi_starting_entry, wifi_starting_run,
+				 wifi_starting_exit, NULL, NULL),
+	[WIFI_STATE_ACTIVE] = SMF_CREATE_STATE(
+		wifi_active_entry, wifi_active_run, NULL, NULL, NULL),
+	[WIFI_STATE_ERROR] = SMF_CREATE_STATE(
+		wifi_error_entry, wifi_error_run, wifi_error_exit, NULL, NULL),
+};
+
+static const char *const __maybe_unused wifi_state_names[] = {
+	[WIFI_STATE_IDLE] = "idle",
+	[WIFI_STATE_ACS] = "acs",
+	[WIFI_STATE_STARTING] = "starting",
+	[WIFI_STATE_ACTIVE] = "active",
+	[WIFI_STATE_ERROR] = "error",
 };
 
 /* WiFi state machine object */
@@ -58,14 +96,310 @@ struct wifi_sm_object {
 	bool softap_ready;
 	bool start_requested;
 	int error_code;
+	/* Set by NET_EVENT_WIFI_AP_ENABLE_RESULT, consumed by STARTING */
+	bool ap_result_ready;
+	int ap_result;
+#if defined(CONFIG_WIFI_RECOVERY)
+	/* Set when the enable result timed out or the backoff expired */
+	bool start_timed_out;
+	bool retry_due;
+	/* Failures since the SoftAP was last active */
+	uint32_t consecutive_failures;
+#endif
+	/* Channel the SoftAP is started on */
+	enum wifi_frequency_bands band;
+	uint8_t channel;
+#if defined(CONFIG_WIFI_ACS)
+	struct acs_ctx acs;
+	bool acs_done;
+	int acs_status;
+#endif
 };
 
 static struct wifi_sm_object wifi_sm;
 
+/* Runs the state machine on the event loop */
+static void wifi_run_fn(struct k_work *work);
+
+static K_WORK_DEFINE(wifi_run_work, wifi_run_fn);
+
 /* Network management callbacks */
 static struct net_mgmt_event_callback wifi_mgmt_cb;
 static struct net_mgmt_event_callback net_mgmt_cb;
 
+/* ============================================================================
+ * SOFTAP CONTROL
+ * ============================================================================
+ */
+
+static int ap_net_mgmt_enable(struct net_if *iface,
+			      struct wifi_connect_req_params *params)
+{
+	return net_mgmt(NET_REQUEST_WIFI_AP_ENABLE, iface, params,
+			sizeof(struct wifi_connect_req_params));
+}
+
+static int ap_net_mgmt_disable(struct net_if *iface)
+{
+	return net_mgmt(NET_REQUEST_WIFI_AP_DISABLE, iface, NULL, 0);
+}
+
+static const struct wifi_ap_ops ap_net_mgmt_ops = {
+	.name = "net_mgmt",
+	.enable = ap_net_mgmt_enable,
+	.disable = ap_net_mgmt_disable,
+};
+
+#if CONFIG_WIFI_FAULT_INJECT_AP_ENABLE > 0
+/* Fails the first N enable requests, then defers to net_mgmt */
+static int ap_fault_enable(struct net_if *iface,
+			   struct wifi_connect_req_params *params)
+{
+	static int injected;
+
+	if (injected < CONFIG_WIFI_FAULT_INJECT_AP_ENABLE) {
+		injected++;
+		LOG_WRN("Injected SoftAP enable failure %d/%d", injected,
+			CONFIG_WIFI_FAULT_INJECT_AP_ENABLE);
+		return -EIO;
+	}
+
+	return ap_net_mgmt_enable(iface, params);
+}
+
+static const struct wifi_ap_ops ap_fault_ops = {
+	.name = "fault_inject",
+	.enable = ap_fault_enable,
+	.disable = ap_net_mgmt_disable,
+};
+
+static const struct wifi_ap_ops *ap_ops = &ap_fault_ops;
+#else
+static const struct wifi_ap_ops *ap_ops = &ap_net_mgmt_ops;
+#endif
+
+/* ============================================================================
+ * FAULT RECOVERY
+ * ============================================================================
+ */
+
+#if defined(CONFIG_WIFI_RECOVERY)
+struct wifi_recovery_stats {
+	uint32_t failures;
+	uint32_t retries;
+	uint32_t recoveries;
+	int last_error;
+	uint32_t backoff_ms;
+	uint32_t last_recovery_ms;
+	uint32_t max_recovery_ms;
+	/* Uptime of the first failure of the current outage, 0 when up */
+	int64_t outage_start;
+};
+
+static struct wifi_recovery_stats recovery_stats;
+static struct k_spinlock recovery_lock;
+
+static void wifi_retry_fn(struct k_work *work);
+static void wifi_start_timeout_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(wifi_retry_work, wifi_retry_fn);
+static K_WORK_DELAYABLE_DEFINE(wifi_start_timeout_work, wifi_start_timeout_fn);
+
+static void wifi_retry_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	wifi_sm.retry_due = true;
+	event_loop_submit(&wifi_run_work);
+}
+
+static void wifi_start_timeout_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	wifi_sm.start_timed_out = true;
+	event_loop_submit(&wifi_run_work);
+}
+
+/* Exponential backoff: MIN, 2*MIN, 4*MIN, ... capped at MAX */
+static uint32_t wifi_backoff_ms(uint32_t failures)
+{
+	uint32_t shift = MIN(failures > 0 ? failures - 1 : 0, 16U);
+	uint64_t delay = (uint64_t)CONFIG_WIFI_RECOVERY_BACKOFF_MIN_MS << shift;
+
+	delay = MIN(delay, (uint64_t)CONFIG_WIFI_RECOVERY_BACKOFF_MAX_MS);
+
+	return (uint32_t)delay;
+}
+
+/* Stop the SoftAP and DHCP server so the next attempt starts clean */
+static void wifi_teardown(struct net_if *iface)
+{
+	int ret;
+
+	if (!iface) {
+		return;
+	}
+
+	ret = ap_ops->disable(iface);
+	if (ret) {
+		LOG_DBG("SoftAP disable: %d", ret);
+	}
+
+	ret = net_dhcpv4_server_stop(iface);
+	if (ret && ret != -ENOENT) {
+		LOG_DBG("DHCP server stop: %d", ret);
+	}
+}
+#endif /* CONFIG_WIFI_RECOVERY */
+
+/* ============================================================================
+ * CHANNEL SELECTION
+ * ============================================================================
+ */
+
+static void wifi_set_reg_domain(struct net_if *iface)
+{
+	struct wifi_reg_domain regd = {0};
+	int ret;
+
+	regd.oper = WIFI_MGMT_SET;
+	strncpy(regd.country_code, "US", WIFI_COUNTRY_CODE_LEN + 1);
+	ret = net_mgmt(NET_REQUEST_WIFI_REG_DOMAIN, iface, &regd, sizeof(regd));
+	if (ret) {
+		LOG_WRN("Failed to set regulatory domain: %d", ret);
+		/* Continue anyway, not fatal */
+	}
+}
+
+#if defined(CONFIG_WIFI_ACS)
+/* Scan in progress on the net_mgmt source. Results arrive on the net_mgmt
+ * thread while completion and timeout run on the event loop, so the
+ * context and callback are claimed under acs_lock and handed out once.
+ */
+static struct acs_ctx *acs_scan_ctx;
+static acs_scan_done_cb_t acs_scan_done;
+static struct k_spinlock acs_lock;
+/* Set from scan start until the driver reports NET_EVENT_WIFI_SCAN_DONE */
+static atomic_t acs_scan_in_flight;
+static int acs_scan_status;
+
+static void acs_timeout_fn(struct k_work *work);
+static void acs_scan_done_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(acs_timeout_work, acs_timeout_fn);
+static K_WORK_DEFINE(acs_scan_done_work, acs_scan_done_fn);
+
+/* Stop feeding results and take the completion callback, if still set */
+static acs_scan_done_cb_t acs_scan_detach(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&acs_lock);
+	acs_scan_done_cb_t done = acs_scan_done;
+
+	acs_scan_ctx = NULL;
+	acs_scan_done = NULL;
+	k_spin_unlock(&acs_lock, key);
+
+	return done;
+}
+
+/* Live scan source: results arrive as NET_EVENT_WIFI_SCAN_RESULT */
+static int acs_net_mgmt_start(struct acs_ctx *ctx, acs_scan_done_cb_t done)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_scan_params params = {0};
+	k_spinlock_key_t key;
+	int ret;
+
+	if (!iface) {
+		return -ENODEV;
+	}
+
+	params.bands = BIT(WIFI_FREQ_BAND_2_4_GHZ);
+	if (sizeof(CONFIG_WIFI_ACS_CHANNELS_5G) > 1) {
+		params.bands |= BIT(WIFI_FREQ_BAND_5_GHZ);
+	}
+
+	key = k_spin_lock(&acs_lock);
+	acs_scan_ctx = ctx;
+	acs_scan_done = done;
+	k_spin_unlock(&acs_lock, key);
+	atomic_set(&acs_scan_in_flight, 1);
+
+	ret = net_mgmt(NET_REQUEST_WIFI_SCAN, iface, &params, sizeof(params));
+	if (ret) {
+		(void)acs_scan_detach();
+		atomic_clear(&acs_scan_in_flight);
+	}
+
+	return ret;
+}
+
+static const struct acs_scan_source acs_net_mgmt_source = {
+	.name = "net_mgmt",
+	.start = acs_net_mgmt_start,
+};
+
+static const struct acs_scan_source *acs_source = &acs_net_mgmt_source;
+
+static void acs_scan_result(const struct wifi_scan_result *entry)
+{
+	struct acs_bss bss = {
+		.band = (entry->band == WIFI_FREQ_BAND_5_GHZ)
+				? ACS_BAND_5_GHZ
+				: ACS_BAND_2_4_GHZ,
+		.channel = entry->channel,
+		.rssi = entry->rssi,
+	};
+	k_spinlock_key_t key = k_spin_lock(&acs_lock);
+
+	if (acs_scan_ctx) {
+		acs_add_bss(acs_scan_ctx, &bss);
+	}
+	k_spin_unlock(&acs_lock, key);
+}
+
+static void acs_scan_done_fn(struct k_work *work)
+{
+	acs_scan_done_cb_t done = acs_scan_detach();
+
+	ARG_UNUSED(work);
+
+	if (done) {
+		done(&wifi_sm.acs, acs_scan_status);
+	} else {
+		/* Timed out earlier, ACS was waiting for the radio */
+		k_work_cancel_delayable(&acs_timeout_work);
+		event_loop_submit(&wifi_run_work);
+	}
+}
+
+static void acs_timeout_fn(struct k_work *work)
+{
+	acs_scan_done_cb_t done = acs_scan_detach();
+
+	ARG_UNUSED(work);
+
+	if (done) {
+		LOG_WRN("ACS scan timed out");
+		done(&wifi_sm.acs, -ETIMEDOUT);
+		/* The driver owns the radio until it reports the scan done,
+		 * so give it one more period before enabling the AP
+		 */
+		if (atomic_get(&acs_scan_in_flight)) {
+			event_loop_schedule(
+				&acs_timeout_work,
+				K_MSEC(CONFIG_WIFI_ACS_SCAN_TIMEOUT_MS));
+		}
+		return;
+	}
+
+	LOG_WRN("Scan still not done, enabling the SoftAP anyway");
+	atomic_clear(&acs_scan_in_flight);
+	event_loop_submit(&wifi_run_work);
+}
+#endif /* CONFIG_WIFI_ACS */
+
 /* ============================================================================
  * STATE MACHINE IMPLEMENTATIONS
  * ============================================================================
@@ -76,6 +410,125 @@ static void wifi_idle_entry(void *obj)
 	LOG_INF("WiFi in IDLE state");
 }
 
+#if defined(CONFIG_WIFI_ACS)
+/* Runs on the event loop, once per scan */
+static void wifi_acs_scan_done(struct acs_ctx *ctx, int status)
+{
+	ARG_UNUSED(ctx);
+
+	k_work_cancel_delayable(&acs_timeout_work);
+
+	wifi_sm.acs_status = status;
+	wifi_sm.acs_done = true;
+
+	event_loop_submit(&wifi_run_work);
+}
+
+/* Start on the configured channel rather than the previous scan's pick */
+static void wifi_acs_fallback(struct wifi_sm_object *sm)
+{
+	sm->band = WIFI_FREQ_BAND_2_4_GHZ;
+	sm->channel = CONFIG_WIFI_AP_CHANNEL;
+	smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_STARTING]);
+}
+
+static void wifi_acs_entry(void *obj)
+{
+	struct wifi_sm_object *sm = (struct wifi_sm_object *)obj;
+	struct net_if *iface = net_if_get_first_wifi();
+	int ret;
+
+	sm->acs_done = false;
+	sm->acs_status = 0;
+
+	ret = acs_add_candidates(&sm->acs, ACS_BAND_2_4_GHZ,
+				 CONFIG_WIFI_ACS_CHANNELS_2G, true);
+	if (ret >= 0) {
+		ret = acs_add_candidates(&sm->acs, ACS_BAND_5_GHZ,
+					 CONFIG_WIFI_ACS_CHANNELS_5G, false);
+	}
+	if (ret < 0 || sm->acs.num_channels == 0) {
+		LOG_WRN("Invalid ACS candidate list, using channel %d",
+			CONFIG_WIFI_AP_CHANNEL);
+		wifi_acs_fallback(sm);
+		return;
+	}
+
+	if (iface) {
+		wifi_set_reg_domain(iface);
+	}
+
+	LOG_INF("Scanning %d candidate channels (source: %s)",
+		(int)sm->acs.num_channels, acs_source->name);
+
+	event_loop_schedule(&acs_timeout_work,
+			K_MSEC(CONFIG_WIFI_ACS_SCAN_TIMEOUT_MS));
+
+	ret = acs_source->start(&sm->acs, wifi_acs_scan_done);
+	if (ret) {
+		LOG_WRN("ACS scan failed to start (%d), using channel %d",
+			ret, CONFIG_WIFI_AP_CHANNEL);
+		k_work_cancel_delayable(&acs_timeout_work);
+		wifi_acs_fallback(sm);
+	}
+}
+
+static enum smf_state_result wifi_acs_run(void *obj)
+{
+	struct wifi_sm_object *sm = (struct wifi_sm_object *)obj;
+	const struct acs_channel *best;
+
+	/* Enabling the AP while a timed out scan still runs would fail */
+	if (!sm->acs_done || atomic_get(&acs_scan_in_flight)) {
+		return SMF_EVENT_HANDLED;
+	}
+
+	best = (sm->acs_status == 0) ? acs_select(&sm->acs) : NULL;
+	if (best) {
+		sm->channel = best->channel;
+		sm->band = (best->band == ACS_BAND_5_GHZ)
+				   ? WIFI_FREQ_BAND_5_GHZ
+				   : WIFI_FREQ_BAND_2_4_GHZ;
+		boot_timeline_mark(BOOT_PHASE_ACS_DONE);
+		LOG_INF("ACS: %u BSSs seen, channel %u selected "
+			"(score %u, %u co-channel)",
+			sm->acs.bss_total, best->channel, best->score,
+			best->bss_count);
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_STARTING]);
+	} else {
+		LOG_WRN("ACS failed (%d), using channel %d", sm->acs_status,
+			CONFIG_WIFI_AP_CHANNEL);
+		wifi_acs_fallback(sm);
+	}
+
+	return SMF_EVENT_HANDLED;
+}
+
+static void wifi_acs_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	k_work_cancel_delayable(&acs_timeout_work);
+}
+#else
+static void wifi_acs_entry(void *obj)
+{
+	smf_set_state(SMF_CTX(obj), &wifi_states[WIFI_STATE_STARTING]);
+}
+
+static enum smf_state_result wifi_acs_run(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	return SMF_EVENT_HANDLED;
+}
+
+static void wifi_acs_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+}
+#endif /* CONFIG_WIFI_ACS */
+
 static void wifi_starting_entry(void *obj)
 {
 	struct wifi_sm_object *sm = (struct wifi_sm_object *)obj;
@@ -83,23 +536,19 @@ static void wifi_starting_entry(void *obj)
 
 	LOG_INF("Starting WiFi SoftAP...");
 
+	sm->softap_ready = false;
+	sm->ap_result_ready = false;
+
 	struct net_if *iface = net_if_get_first_wifi();
 	if (!iface) {
 		LOG_ERR("No WiFi interface found");
 		sm->error_code = -ENODEV;
-		smf_set_state(SMF_CTX(sm), &wifi_states[3]);
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_ERROR]);
 		return;
 	}
 
 	/* Set regulatory domain */
-	struct wifi_reg_domain regd = {0};
-	regd.oper = WIFI_MGMT_SET;
-	strncpy(regd.country_code, "US", WIFI_COUNTRY_CODE_LEN + 1);
-	ret = net_mgmt(NET_REQUEST_WIFI_REG_DOMAIN, iface, &regd, sizeof(regd));
-	if (ret) {
-		LOG_WRN("Failed to set regulatory domain: %d", ret);
-		/* Continue anyway, not fatal */
-	}
+	wifi_set_reg_domain(iface);
 
 	/* Setup DHCP server */
 	struct in_addr pool_start;
@@ -122,20 +571,28 @@ static void wifi_starting_entry(void *obj)
 		.psk = (uint8_t *)CONFIG_APP_WIFI_PASSWORD,
 		.psk_length = strlen(CONFIG_APP_WIFI_PASSWORD),
 		.security = WIFI_SECURITY_TYPE_PSK,
-		.band = WIFI_FREQ_BAND_2_4_GHZ,
-		.channel = 1,
+		.band = sm->band,
+		.channel = sm->channel,
 	};
 
-	ret = net_mgmt(NET_REQUEST_WIFI_AP_ENABLE, iface, &params,
-		       sizeof(struct wifi_connect_req_params));
+	ret = ap_ops->enable(iface, &params);
 	if (ret) {
 		LOG_ERR("Failed to enable SoftAP: %d", ret);
 		sm->error_code = ret;
-		smf_set_state(SMF_CTX(sm), &wifi_states[3]);
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_ERROR]);
 		return;
 	}
 
-	LOG_INF("SoftAP enable requested: SSID='%s'", CONFIG_APP_WIFI_SSID);
+	boot_timeline_mark(BOOT_PHASE_AP_ENABLE_REQUESTED);
+	LOG_INF("SoftAP enable requested: SSID='%s', channel %u",
+		CONFIG_APP_WIFI_SSID, sm->channel);
+
+#if defined(CONFIG_WIFI_RECOVERY)
+	/* A lost enable result is treated as a failure */
+	sm->start_timed_out = false;
+	event_loop_schedule(&wifi_start_timeout_work,
+			K_MSEC(CONFIG_WIFI_RECOVERY_ENABLE_TIMEOUT_MS));
+#endif
 
 	/* Message will be published when SoftAP is actually started (in event*/
 	/* handler)*/
@@ -145,25 +602,75 @@ static enum smf_state_result wifi_starting_run(void *obj)
 {
 	struct wifi_sm_object *sm = (struct wifi_sm_object *)obj;
 
-	if (sm->softap_ready) {
-		smf_set_state(SMF_CTX(sm), &wifi_states[2]);
+#if defined(CONFIG_WIFI_RECOVERY)
+	if (sm->start_timed_out && !sm->ap_result_ready) {
+		LOG_ERR("No SoftAP enable result within %d ms",
+			CONFIG_WIFI_RECOVERY_ENABLE_TIMEOUT_MS);
+		sm->error_code = -ETIMEDOUT;
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_ERROR]);
+		return SMF_EVENT_HANDLED;
+	}
+#endif
+
+	if (!sm->ap_result_ready) {
+		return SMF_EVENT_HANDLED;
+	}
+
+	if (sm->ap_result == 0) {
+		sm->softap_ready = true;
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_ACTIVE]);
+	} else {
+		sm->error_code = sm->ap_result;
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_ERROR]);
 	}
 
 	return SMF_EVENT_HANDLED;
 }
 
+static void wifi_starting_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+
+#if defined(CONFIG_WIFI_RECOVERY)
+	k_work_cancel_delayable(&wifi_start_timeout_work);
+#endif
+}
+
 static void wifi_active_entry(void *obj)
 {
+	struct wifi_sm_object *sm = (struct wifi_sm_object *)obj;
 	struct wifi_msg msg;
 
 	LOG_INF("WiFi SoftAP active");
 
+#if defined(CONFIG_WIFI_RECOVERY)
+	if (sm->consecutive_failures > 0) {
+		k_spinlock_key_t key = k_spin_lock(&recovery_lock);
+		uint32_t outage_ms = (uint32_t)(k_uptime_get() -
+						recovery_stats.outage_start);
+
+		recovery_stats.recoveries++;
+		recovery_stats.last_recovery_ms = outage_ms;
+		recovery_stats.max_recovery_ms =
+			MAX(recovery_stats.max_recovery_ms, outage_ms);
+		recovery_stats.outage_start = 0;
+		recovery_stats.backoff_ms = 0;
+		k_spin_unlock(&recovery_lock, key);
+
+		LOG_INF("SoftAP recovered after %u failures in %u ms",
+			sm->consecutive_failures, outage_ms);
+		sm->consecutive_failures = 0;
+	}
+#endif
+
 	msg.type = WIFI_SOFTAP_STARTED;
 	snprintf(msg.ssid, sizeof(msg.ssid), "%s", CONFIG_APP_WIFI_SSID);
-	msg.channel = 0;
+	msg.channel = sm->channel;
 	msg.error_code = 0;
 
-	zbus_chan_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+	APP_TRACE_BEGIN("wifi_pub", msg.type);
+	zbus_stats_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+	APP_TRACE_END("wifi_pub", msg.type);
 }
 
 static enum smf_state_result wifi_active_run(void *obj)
@@ -182,7 +689,64 @@ static void wifi_error_entry(void *obj)
 	msg.type = WIFI_ERROR;
 	msg.error_code = sm->error_code;
 
-	zbus_chan_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+	APP_TRACE_BEGIN("wifi_pub", msg.type);
+	zbus_stats_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+	APP_TRACE_END("wifi_pub", msg.type);
+
+#if defined(CONFIG_WIFI_RECOVERY)
+	uint32_t backoff_ms;
+	k_spinlock_key_t key;
+
+	sm->softap_ready = false;
+	sm->retry_due = false;
+	sm->consecutive_failures++;
+	backoff_ms = wifi_backoff_ms(sm->consecutive_failures);
+
+	key = k_spin_lock(&recovery_lock);
+	recovery_stats.failures++;
+	recovery_stats.last_error = sm->error_code;
+	recovery_stats.backoff_ms = backoff_ms;
+	if (recovery_stats.outage_start == 0) {
+		recovery_stats.outage_start = k_uptime_get();
+	}
+	k_spin_unlock(&recovery_lock, key);
+
+	wifi_teardown(net_if_get_first_wifi());
+
+	LOG_WRN("Retrying SoftAP in %u ms (failure %u)", backoff_ms,
+		sm->consecutive_failures);
+	event_loop_schedule(&wifi_retry_work, K_MSEC(backoff_ms));
+#endif
+}
+
+static enum smf_state_result wifi_error_run(void *obj)
+{
+#if defined(CONFIG_WIFI_RECOVERY)
+	struct wifi_sm_object *sm = (struct wifi_sm_object *)obj;
+
+	if (sm->retry_due) {
+		k_spinlock_key_t key = k_spin_lock(&recovery_lock);
+
+		recovery_stats.retries++;
+		k_spin_unlock(&recovery_lock, key);
+
+		/* Rescan, the failure may have been channel related */
+		smf_set_state(SMF_CTX(sm), &wifi_states[WIFI_STATE_ACS]);
+	}
+#else
+	ARG_UNUSED(obj);
+#endif
+
+	return SMF_EVENT_HANDLED;
+}
+
+static void wifi_error_exit(void *obj)
+{
+	ARG_UNUSED(obj);
+
+#if defined(CONFIG_WIFI_RECOVERY)
+	k_work_cancel_delayable(&wifi_retry_work);
+#endif
 }
 
 /* ============================================================================
@@ -202,14 +766,17 @@ static void wifi_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 
 		if (status->status == 0) {
 			LOG_INF("SoftAP enabled successfully");
-			wifi_sm.softap_ready = true;
-			smf_run_state(SMF_CTX(&wifi_sm));
+			boot_timeline_mark(BOOT_PHASE_AP_ENABLED);
 		} else {
 			LOG_ERR("SoftAP enable failed: %d", status->status);
-			wifi_sm.error_code = status->status;
-			smf_set_state(SMF_CTX(&wifi_sm), &wifi_states[3]);
-			smf_run_state(SMF_CTX(&wifi_sm));
 		}
+
+		/* Teardown and retry issue net_mgmt requests, so the state
+		 * machine runs on the event loop rather than here
+		 */
+		wifi_sm.ap_result = status->status;
+		wifi_sm.ap_result_ready = true;
+		event_loop_submit(&wifi_run_work);
 		break;
 	}
 
@@ -223,7 +790,9 @@ static void wifi_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 		struct wifi_msg msg = {
 			.type = WIFI_CLIENT_CONNECTED,
 		};
-		zbus_chan_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+		APP_TRACE_BEGIN("wifi_pub", msg.type);
+		zbus_stats_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+		APP_TRACE_END("wifi_pub", msg.type);
 		break;
 	}
 
@@ -237,9 +806,29 @@ static void wifi_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 		struct wifi_msg msg = {
 			.type = WIFI_CLIENT_DISCONNECTED,
 		};
-		zbus_chan_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+		APP_TRACE_BEGIN("wifi_pub", msg.type);
+		zbus_stats_pub(&WIFI_CHAN, &msg, K_NO_WAIT);
+		APP_TRACE_END("wifi_pub", msg.type);
+		break;
+	}
+
+#if defined(CONFIG_WIFI_ACS)
+	case NET_EVENT_WIFI_SCAN_RESULT:
+		acs_scan_result((const struct wifi_scan_result *)cb->info);
+		break;
+
+	case NET_EVENT_WIFI_SCAN_DONE: {
+		const struct wifi_status *status =
+			(const struct wifi_status *)cb->info;
+
+		/* Completion runs on the event loop, like the timeout */
+		if (atomic_cas(&acs_scan_in_flight, 1, 0)) {
+			acs_scan_status = status->status ? -EIO : 0;
+			event_loop_submit(&acs_scan_done_work);
+		}
 		break;
 	}
+#endif /* CONFIG_WIFI_ACS */
 
 	default:
 		break;
@@ -255,6 +844,7 @@ static void net_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 	switch (mgmt_event) {
 	case NET_EVENT_IPV4_ADDR_ADD:
 		LOG_INF("IPv4 address added");
+		boot_timeline_mark(BOOT_PHASE_IPV4_READY);
 		break;
 
 	default:
@@ -269,38 +859,134 @@ static void net_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 
 int wifi_start_softap(void)
 {
+	int ret;
+
 	wifi_sm.start_requested = true;
-	smf_set_state(SMF_CTX(&wifi_sm), &wifi_states[1]);
-	return smf_run_state(SMF_CTX(&wifi_sm));
+	smf_set_state(SMF_CTX(&wifi_sm), &wifi_states[WIFI_STATE_ACS]);
+
+	APP_TRACE_BEGIN("wifi_smf", 0);
+	ret = smf_run_state(SMF_CTX(&wifi_sm));
+	APP_TRACE_END("wifi_smf", 0);
+
+	return ret;
+}
+
+void wifi_set_ap_ops(const struct wifi_ap_ops *ops)
+{
+	ap_ops = ops ? ops : &ap_net_mgmt_ops;
+}
+
+#if defined(CONFIG_WIFI_RECOVERY)
+int wifi_recovery_json(char *buf, size_t buf_len)
+{
+	struct wifi_recovery_stats stats;
+	const struct smf_state *current;
+	const char *state = "unknown";
+	uint32_t outage_ms = 0;
+	int written;
+
+	if (!buf || buf_len == 0) {
+		return -EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&recovery_lock);
+	stats = recovery_stats;
+	k_spin_unlock(&recovery_lock, key);
+
+	current = SMF_CTX(&wifi_sm)->current;
+	if (current >= &wifi_states[0] &&
+	    current < &wifi_states[ARRAY_SIZE(wifi_states)]) {
+		state = wifi_state_names[current - wifi_states];
+	}
+
+	if (stats.outage_start != 0) {
+		outage_ms = (uint32_t)(k_uptime_get() - stats.outage_start);
+	}
+
+	written = snprintf(buf, buf_len,
+			   "{\"state\":\"%s\",\"ap_ops\":\"%s\","
+			   "\"failures\":%u,\"retries\":%u,"
+			   "\"recoveries\":%u,\"last_error\":%d,"
+			   "\"backoff_ms\":%u,\"outage_ms\":%u,"
+			   "\"last_recovery_ms\":%u,\"max_recovery_ms\":%u}",
+			   state, ap_ops->name, stats.failures, stats.retries,
+			   stats.recoveries, stats.last_error, stats.backoff_ms,
+			   outage_ms, stats.last_recovery_ms,
+			   stats.max_recovery_ms);
+	if (written < 0 || written >= (int)buf_len) {
+		return -ENOMEM;
+	}
+
+	return written;
+}
+#endif /* CONFIG_WIFI_RECOVERY */
+
+#if defined(CONFIG_WIFI_ACS)
+void wifi_acs_set_scan_source(const struct acs_scan_source *source)
+{
+	acs_source = source ? source : &acs_net_mgmt_source;
 }
+#endif
 
 /* ============================================================================
- * WiFi THREAD
+ * EVENT LOOP WORK
  * ============================================================================
  */
 
-static void wifi_thread_fn(void *arg1, void *arg2, void *arg3)
+/* Readiness is polled during boot so that startup never blocks the loop */
+#define WIFI_READY_POLL_MS 50
+
+static void wifi_run_fn(struct k_work *work)
 {
-	ARG_UNUSED(arg1);
-	ARG_UNUSED(arg2);
-	ARG_UNUSED(arg3);
+	ARG_UNUSED(work);
 
-	LOG_INF("WiFi module thread started");
+	APP_TRACE_BEGIN("wifi_smf", 0);
+	smf_run_state(SMF_CTX(&wifi_sm));
+	APP_TRACE_END("wifi_smf", 0);
+}
 
-	/* Give system time to initialize */
-	k_sleep(K_SECONDS(2));
+static void wifi_start_fn(struct k_work *work);
 
-	/* Start SoftAP */
-	wifi_start_softap();
+static K_WORK_DELAYABLE_DEFINE(wifi_start_work, wifi_start_fn);
+
+static void wifi_start_fn(struct k_work *work)
+{
+	static int64_t deadline;
+	static bool iface_up;
+	static bool supplicant_ready;
 
-	while (1) {
-		k_sleep(K_SECONDS(10));
+	ARG_UNUSED(work);
+
+	if (deadline == 0) {
+		deadline = k_uptime_get() + CONFIG_WIFI_READY_TIMEOUT_MS;
 	}
+
+	iface_up = iface_up || network_wait_for_iface_up(K_NO_WAIT) == 0;
+	supplicant_ready = supplicant_ready ||
+			   network_wait_for_supplicant_ready(K_NO_WAIT) == 0;
+
+	if (!(iface_up && supplicant_ready) && k_uptime_get() < deadline) {
+		event_loop_schedule(&wifi_start_work,
+				    K_MSEC(WIFI_READY_POLL_MS));
+		return;
+	}
+
+	if (!iface_up) {
+		LOG_WRN("WiFi interface not up, starting anyway");
+	}
+
+	if (!supplicant_ready) {
+		LOG_WRN("Supplicant not ready, starting anyway");
+	}
+
+	/* Start SoftAP */
+	wifi_start_softap();
 }
 
-/* Thread stack size increased for SoftAP mode with WPA supplicant */
-K_THREAD_DEFINE(wifi_thread_id, 8192, wifi_thread_fn, NULL, NULL, NULL, 5, 0,
-		0);
+void wifi_module_start(void)
+{
+	event_loop_schedule(&wifi_start_work, K_NO_WAIT);
+}
 
 /* ============================================================================
  * MODULE INITIALIZATION
@@ -315,14 +1001,20 @@ int wifi_module_init(void)
 	wifi_sm.softap_ready = false;
 	wifi_sm.start_requested = false;
 	wifi_sm.error_code = 0;
-	smf_set_initial(SMF_CTX(&wifi_sm), &wifi_states[0]);
+	wifi_sm.band = WIFI_FREQ_BAND_2_4_GHZ;
+	wifi_sm.channel = CONFIG_WIFI_AP_CHANNEL;
+	smf_set_initial(SMF_CTX(&wifi_sm), &wifi_states[WIFI_STATE_IDLE]);
 
 	/* Setup network management callbacks */
 	net_mgmt_init_event_callback(
 		&wifi_mgmt_cb, wifi_mgmt_event_handler,
 		NET_EVENT_WIFI_AP_ENABLE_RESULT |
 			NET_EVENT_WIFI_AP_STA_CONNECTED |
-			NET_EVENT_WIFI_AP_STA_DISCONNECTED);
+			NET_EVENT_WIFI_AP_STA_DISCONNECTED |
+			COND_CODE_1(CONFIG_WIFI_ACS,
+				    (NET_EVENT_WIFI_SCAN_RESULT |
+				     NET_EVENT_WIFI_SCAN_DONE),
+				    (0)));
 	net_mgmt_add_event_callback(&wifi_mgmt_cb);
 
 	net_mgmt_init_event_callback(&net_mgmt_cb, net_mgmt_event_handler,
@@ -12,8 +12,28 @@
 #ifndef WIFI_H
 #define WIFI_H
 
+#include <stddef.h>
 #include <zephyr/kernel.h>
 
+struct net_if;
+struct wifi_connect_req_params;
+
+/**
+ * @brief SoftAP control operations
+ *
+ * The state machine enables and tears down the SoftAP through this table so
+ * that failures can be injected without a radio fault.
+ */
+struct wifi_ap_ops {
+	/** Name reported in diagnostics */
+	const char *name;
+	/** Request AP enable, the result follows as a net_mgmt event */
+	int (*enable)(struct net_if *iface,
+		      struct wifi_connect_req_params *params);
+	/** Disable the AP */
+	int (*disable)(struct net_if *iface);
+};
+
 /**
  * @brief Initialize WiFi module
  * @return 0 on success, negative error code on failure
@@ -22,8 +42,54 @@ int wifi_module_init(void);
 
 /**
  * @brief Start WiFi SoftAP
+ *
+ * Runs the state machine on the calling thread; must be called from the
+ * event loop.
+ *
  * @return 0 on success, negative error code on failure
  */
 int wifi_start_softap(void);
 
+/**
+ * @brief Start the SoftAP from the event loop once the interface and the
+ * supplicant are ready, or after CONFIG_WIFI_READY_TIMEOUT_MS
+ */
+void wifi_module_start(void);
+
+/**
+ * @brief Replace the SoftAP control operations
+ *
+ * Must be called before the SoftAP is started.
+ *
+ * @param ops Operations table, or NULL to restore the net_mgmt backend
+ */
+void wifi_set_ap_ops(const struct wifi_ap_ops *ops);
+
+#if defined(CONFIG_WIFI_RECOVERY)
+/**
+ * @brief Get SoftAP fault recovery statistics as JSON
+ *
+ * Reports the current state, failure and retry counts, the pending backoff
+ * and the time taken by the last and slowest recoveries.
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int wifi_recovery_json(char *buf, size_t buf_len);
+#endif
+
+#if defined(CONFIG_WIFI_ACS)
+struct acs_scan_source;
+
+/**
+ * @brief Replace the scan source used by automatic channel selection
+ *
+ * Must be called before the SoftAP is started.
+ *
+ * @param source Scan source, or NULL to restore the net_mgmt scanner
+ */
+void wifi_acs_set_scan_source(const struct acs_scan_source *source);
+#endif
+
 #endif /* WIFI_H */
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "zbus_stats.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_zbus_stats, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include "../log_ratelimit.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <zephyr/init.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/iterable_sections.h>
+
+#define MAX_CHANNELS  CONFIG_APP_ZBUS_STATS_MAX_CHANNELS
+#define MAX_OBSERVERS CONFIG_APP_ZBUS_STATS_MAX_OBSERVERS
+#define SLOW_NS       ((uint32_t)CONFIG_APP_ZBUS_STATS_SLOW_US * 1000U)
+/* Publish rates are reported over windows of this length */
+#define RATE_WINDOW_MS 10000U
+
+struct chan_stats {
+	const struct zbus_channel *chan;
+	uint32_t pubs;
+	uint32_t failed;
+	/* -EAGAIN or -EBUSY: the channel lock was not taken in time */
+	uint32_t timeouts;
+	int last_err;
+	uint32_t max_ns;
+	uint64_t total_ns;
+	uint32_t wait_max_ns;
+	uint64_t wait_total_ns;
+	uint32_t window_start_ms;
+	uint32_t window_pubs;
+	uint32_t per_min;
+};
+
+struct obs_stats {
+	const struct zbus_channel *chan;
+	const struct zbus_observer *obs;
+	uint32_t runs;
+	uint32_t slow;
+	uint32_t max_ns;
+	uint64_t total_ns;
+};
+
+/* Publication in progress, reached through the thread's custom data so
+ * that listeners, which run on the publishing thread, can report back
+ */
+struct pub_ctx {
+	const struct zbus_channel *chan;
+	uint64_t obs_ns;
+};
+
+/* Both tables are filled at init from the linker sections and only their
+ * counters change afterwards, so lookups need no lock
+ */
+static struct chan_stats chan_table[MAX_CHANNELS];
+static struct obs_stats obs_table[MAX_OBSERVERS];
+static size_t chan_count;
+static size_t obs_count;
+static struct k_spinlock lock;
+
+static uint32_t cycles_to_ns(timing_t start, timing_t end)
+{
+	uint64_t cycles = timing_cycles_get(&start, &end);
+
+	return (uint32_t)MIN(timing_cycles_to_ns(cycles), UINT32_MAX);
+}
+
+static struct chan_stats *chan_find(const struct zbus_channel *chan)
+{
+	for (size_t i = 0; i < chan_count; i++) {
+		if (chan_table[i].chan == chan) {
+			return &chan_table[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct obs_stats *obs_find(const struct zbus_observer *obs,
+				  const struct zbus_channel *chan)
+{
+	for (size_t i = 0; i < obs_count; i++) {
+		if (obs_table[i].obs == obs && obs_table[i].chan == chan) {
+			return &obs_table[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Called with lock held */
+static uint32_t rate_per_min(const struct chan_stats *stats, uint32_t now)
+{
+	uint32_t elapsed = now - stats->window_start_ms;
+
+	if (elapsed >= RATE_WINDOW_MS) {
+		return (uint32_t)((uint64_t)stats->window_pubs * 60000U /
+				  elapsed);
+	}
+
+	return stats->per_min;
+}
+
+/* ============================================================================
+ * RECORDING
+ * ============================================================================
+ */
+
+int zbus_stats_pub(const struct zbus_channel *chan, const void *msg,
+		   k_timeout_t timeout)
+{
+	struct chan_stats *stats = chan_find(chan);
+	struct pub_ctx ctx = {.chan = chan};
+	k_spinlock_key_t key;
+	timing_t start;
+	timing_t end;
+	void *outer;
+	uint32_t now;
+	uint32_t ns;
+	uint32_t wait_ns;
+	int ret;
+
+	if (!stats || k_is_in_isr()) {
+		return zbus_chan_pub(chan, msg, timeout);
+	}
+
+	/* Restored afterwards, a listener may publish to another channel */
+	outer = k_thread_custom_data_get();
+	k_thread_custom_data_set(&ctx);
+
+	start = timing_counter_get();
+	ret = zbus_chan_pub(chan, msg, timeout);
+	end = timing_counter_get();
+
+	k_thread_custom_data_set(outer);
+
+	ns = cycles_to_ns(start, end);
+	wait_ns = ns - (uint32_t)MIN(ctx.obs_ns, ns);
+	now = k_uptime_get_32();
+
+	key = k_spin_lock(&lock);
+
+	stats->pubs++;
+	stats->total_ns += ns;
+	stats->max_ns = MAX(stats->max_ns, ns);
+	stats->wait_total_ns += wait_ns;
+	stats->wait_max_ns = MAX(stats->wait_max_ns, wait_ns);
+
+	if (ret < 0) {
+		stats->failed++;
+		stats->last_err = ret;
+		if (ret == -EAGAIN || ret == -EBUSY) {
+			stats->timeouts++;
+		}
+	}
+
+	if (now - stats->window_start_ms >= RATE_WINDOW_MS) {
+		stats->per_min = rate_per_min(stats, now);
+		stats->window_start_ms = now;
+		stats->window_pubs = 0;
+	}
+	stats->window_pubs++;
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+void zbus_stats_obs_record(const struct zbus_observer *obs,
+			   const struct zbus_channel *chan, timing_t start)
+{
+	const timing_t end = timing_counter_get();
+	struct obs_stats *stats = obs_find(obs, chan);
+	struct pub_ctx *ctx = k_is_in_isr() ? NULL : k_thread_custom_data_get();
+	uint32_t ns = cycles_to_ns(start, end);
+	k_spinlock_key_t key;
+
+	if (ctx && ctx->chan == chan) {
+		ctx->obs_ns += ns;
+	}
+
+	if (!stats) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+	stats->runs++;
+	stats->total_ns += ns;
+	stats->max_ns = MAX(stats->max_ns, ns);
+	if (ns > SLOW_NS) {
+		stats->slow++;
+	}
+	k_spin_unlock(&lock, key);
+
+	if (ns > SLOW_NS) {
+		APP_LOG_WRN_RL("Listener %s held %s for %u us",
+			       zbus_obs_name(obs), zbus_chan_name(chan),
+			       ns / 1000U);
+	}
+}
+
+/* ============================================================================
+ * JSON REPORT
+ * ============================================================================
+ */
+
+/* Report items: header, channels, observer list opening, observers,
+ * footer
+ */
+#define ITEM_CHAN_FIRST 1U
+#define ITEM_OBS_OPEN   (ITEM_CHAN_FIRST + chan_count)
+#define ITEM_OBS_FIRST  (ITEM_OBS_OPEN + 1U)
+#define ITEM_FOOTER     (ITEM_OBS_FIRST + obs_count)
+
+static int format_channel(char *buf, size_t buf_len, uint32_t index)
+{
+	const uint32_t now = k_uptime_get_32();
+	struct chan_stats stats;
+	uint32_t per_min;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+	stats = chan_table[index];
+	per_min = rate_per_min(&stats, now);
+	k_spin_unlock(&lock, key);
+
+	return snprintf(buf, buf_len,
+			"%s{\"name\":\"%s\",\"pubs\":%u,\"per_min\":%u,"
+			"\"failed\":%u,\"timeouts\":%u,\"last_err\":%d,"
+			"\"avg_ns\":%u,\"max_ns\":%u,\"wait_avg_ns\":%u,"
+			"\"wait_max_ns\":%u}",
+			index == 0U ? "" : ",", zbus_chan_name(stats.chan),
+			stats.pubs, per_min, stats.failed, stats.timeouts,
+			stats.last_err,
+			stats.pubs ? (uint32_t)(stats.total_ns / stats.pubs) : 0,
+			stats.max_ns,
+			stats.pubs ? (uint32_t)(stats.wait_total_ns / stats.pubs)
+				   : 0,
+			stats.wait_max_ns);
+}
+
+static int format_observer(char *buf, size_t buf_len, uint32_t index)
+{
+	struct obs_stats stats;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&lock);
+	stats = obs_table[index];
+	k_spin_unlock(&lock, key);
+
+	return snprintf(buf, buf_len,
+			"%s{\"name\":\"%s\",\"channel\":\"%s\",\"runs\":%u,"
+			"\"avg_ns\":%u,\"max_ns\":%u,\"slow\":%u}",
+			index == 0U ? "" : ",", zbus_obs_name(stats.obs),
+			zbus_chan_name(stats.chan), stats.runs,
+			stats.runs ? (uint32_t)(stats.total_ns / stats.runs) : 0,
+			stats.max_ns, stats.slow);
+}
+
+static int format_item(char *buf, size_t buf_len, uint32_t item)
+{
+	if (item == 0U) {
+		return snprintf(buf, buf_len,
+				"{\"timer_mhz\":%u,\"slow_us\":%u,"
+				"\"channels\":[",
+				timing_freq_get_mhz(),
+				CONFIG_APP_ZBUS_STATS_SLOW_US);
+	}
+
+	if (item < ITEM_OBS_OPEN) {
+		return format_channel(buf, buf_len, item - ITEM_CHAN_FIRST);
+	}
+
+	if (item == ITEM_OBS_OPEN) {
+		return snprintf(buf, buf_len, "],\"observers\":[");
+	}
+
+	if (item < ITEM_FOOTER) {
+		return format_observer(buf, buf_len, item - ITEM_OBS_FIRST);
+	}
+
+	return snprintf(buf, buf_len, "]}");
+}
+
+int zbus_stats_json_chunk(char *buf, size_t buf_len, uint32_t *cursor,
+			  bool *done)
+{
+	int offset = 0;
+	int written;
+
+	if (!buf || buf_len == 0 || !cursor || !done) {
+		return -EINVAL;
+	}
+
+	*done = false;
+
+	while (*cursor <= ITEM_FOOTER) {
+		written = format_item(buf + offset, buf_len - offset, *cursor);
+		if (written < 0 || written >= (int)(buf_len - offset)) {
+			if (offset == 0) {
+				return -ENOMEM;
+			}
+			/* Item goes into the next chunk */
+			buf[offset] = '\0';
+			return offset;
+		}
+
+		offset += written;
+		(*cursor)++;
+	}
+
+	*done = true;
+	return offset;
+}
+
+/* ============================================================================
+ * MODULE INITIALIZATION
+ * ============================================================================
+ */
+
+static int zbus_stats_init(void)
+{
+	size_t skipped = 0;
+
+	timing_init();
+	timing_start();
+
+	STRUCT_SECTION_FOREACH(zbus_channel, chan) {
+		if (chan_count < MAX_CHANNELS) {
+			chan_table[chan_count++].chan = chan;
+		} else {
+			skipped++;
+		}
+	}
+
+	STRUCT_SECTION_FOREACH(zbus_channel_observation, observation) {
+		if (obs_count < MAX_OBSERVERS) {
+			obs_table[obs_count].chan = observation->chan;
+			obs_table[obs_count].obs = observation->obs;
+			obs_count++;
+		} else {
+			skipped++;
+		}
+	}
+
+	if (skipped > 0) {
+		LOG_WRN("%zu channels or observations not tracked", skipped);
+	}
+
+	LOG_INF("Tracking %zu zbus channels, %zu observations", chan_count,
+		obs_count);
+
+	return 0;
+}
+
+SYS_INIT(zbus_stats_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file zbus_stats.h
+ * @brief Zbus channel publish and observer execution statistics
+ *
+ * Publishers call zbus_stats_pub() in place of zbus_chan_pub() and
+ * listeners are defined with ZBUS_STATS_LISTENER_DEFINE() in place of
+ * ZBUS_LISTENER_DEFINE(). Both fall back to the plain zbus calls when
+ * CONFIG_APP_ZBUS_STATS is disabled.
+ */
+
+#ifndef ZBUS_STATS_H
+#define ZBUS_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+
+#if defined(CONFIG_APP_ZBUS_STATS)
+#include <zephyr/timing/timing.h>
+
+/**
+ * @brief Publish to a channel and record the outcome
+ *
+ * Same semantics as zbus_chan_pub(). The time spent in the call that is
+ * not spent in timed listeners of this channel is accounted as wait
+ * time: channel lock contention, message copy and subscriber queueing.
+ */
+int zbus_stats_pub(const struct zbus_channel *chan, const void *msg,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Record one run of a listener, used by ZBUS_STATS_LISTENER_DEFINE
+ */
+void zbus_stats_obs_record(const struct zbus_observer *obs,
+			   const struct zbus_channel *chan, timing_t start);
+
+/**
+ * @brief Write the next fragment of the statistics report as JSON
+ *
+ * @param buf Buffer for the fragment
+ * @param buf_len Buffer length
+ * @param cursor Position in the report, 0 for the first call
+ * @param done Set when the report is complete
+ * @return Number of bytes written, or negative error code
+ */
+int zbus_stats_json_chunk(char *buf, size_t buf_len, uint32_t *cursor,
+			  bool *done);
+
+/**
+ * @brief Define a listener whose run time is recorded per channel
+ */
+#define ZBUS_STATS_LISTENER_DEFINE(_name, _cb)                                 \
+	extern const struct zbus_observer _name;                               \
+	static void _name##_timed(const struct zbus_channel *chan)             \
+	{                                                                      \
+		const timing_t start = timing_counter_get();                   \
+									       \
+		_cb(chan);                                                     \
+		zbus_stats_obs_record(&_name, chan, start);                    \
+	}                                                                      \
+	ZBUS_LISTENER_DEFINE(_name, _name##_timed)
+#else
+static inline int zbus_stats_pub(const struct zbus_channel *chan,
+				 const void *msg, k_timeout_t timeout)
+{
+	return zbus_chan_pub(chan, msg, timeout);
+}
+
+#define ZBUS_STATS_LISTENER_DEFINE(_name, _cb) ZBUS_LISTENER_DEFINE(_name, _cb)
+#endif /* CONFIG_APP_ZBUS_STATS */
+
+#endif /* ZBUS_STATS_H */
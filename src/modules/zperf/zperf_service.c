@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "zperf_service.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app_zperf, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/spinlock.h>
+
+#define RESULT_COUNT CONFIG_APP_ZPERF_RESULTS
+
+enum zperf_service_state {
+	ZPERF_IDLE,
+	ZPERF_LISTENING,
+	ZPERF_UPLOADING,
+};
+
+static const char *const state_names[] = {
+	[ZPERF_IDLE] = "idle",
+	[ZPERF_LISTENING] = "listening",
+	[ZPERF_UPLOADING] = "uploading",
+};
+
+/* One finished (or failed) session */
+struct zperf_record {
+	int64_t finished;
+	uint64_t bytes;
+	uint32_t duration_us;
+	uint32_t packets;
+	uint32_t lost;
+	uint32_t out_of_order;
+	uint32_t jitter_us;
+	bool tcp;
+	bool upload;
+	bool error;
+};
+
+static struct zperf_record results[RESULT_COUNT];
+/* Total sessions recorded, the newest is at (count - 1) % RESULT_COUNT */
+static uint32_t result_count;
+static enum zperf_service_state state;
+static struct zperf_service_params active;
+static struct k_spinlock lock;
+
+static uint32_t rate_kbps(uint64_t bytes, uint32_t duration_us)
+{
+	return duration_us ? (uint32_t)(bytes * 8000U / duration_us) : 0;
+}
+
+/* Called from the zperf work queue or socket service thread */
+static void record_result(const struct zperf_results *zr, bool error)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct zperf_record *rec = &results[result_count % RESULT_COUNT];
+	struct zperf_record done;
+
+	memset(rec, 0, sizeof(*rec));
+	rec->finished = k_uptime_get();
+	rec->tcp = active.tcp;
+	rec->upload = active.upload;
+	rec->error = error;
+
+	if (zr) {
+		rec->bytes = zr->total_len;
+		rec->lost = zr->nb_packets_lost;
+		rec->out_of_order = zr->nb_packets_outorder;
+		rec->jitter_us = zr->jitter_in_us;
+		if (active.upload) {
+			rec->duration_us = zr->client_time_in_us;
+			rec->packets = zr->nb_packets_sent;
+		} else {
+			rec->duration_us = zr->time_in_us;
+			rec->packets = zr->nb_packets_rcvd;
+		}
+	}
+
+	result_count++;
+	done = *rec;
+
+	if (active.upload) {
+		state = ZPERF_IDLE;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (zr) {
+		LOG_INF("zperf %s %s: %llu bytes in %u us, %u kbps",
+			done.tcp ? "TCP" : "UDP",
+			done.upload ? "upload" : "download",
+			(unsigned long long)done.bytes, done.duration_us,
+			rate_kbps(done.bytes, done.duration_us));
+	}
+}
+
+static void zperf_cb(enum zperf_status status, struct zperf_results *zr,
+		     void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	switch (status) {
+	case ZPERF_SESSION_STARTED:
+		LOG_DBG("zperf session started");
+		break;
+	case ZPERF_SESSION_FINISHED:
+		record_result(zr, false);
+		break;
+	case ZPERF_SESSION_ERROR:
+		LOG_WRN("zperf session failed");
+		record_result(NULL, true);
+		break;
+	default:
+		break;
+	}
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================
+ */
+
+int zperf_service_start(const struct zperf_service_params *params)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	/* zperf divides by the rate and sends nothing with empty packets */
+	if (params->upload && (params->rate_kbps == 0 ||
+			       params->packet_size == 0)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	if (state != ZPERF_IDLE) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+	active = *params;
+	state = params->upload ? ZPERF_UPLOADING : ZPERF_LISTENING;
+	k_spin_unlock(&lock, key);
+
+	if (params->upload) {
+		struct zperf_upload_params up = {
+			.duration_ms = params->duration_ms,
+			.rate_kbps = params->rate_kbps,
+			.packet_size = params->packet_size,
+		};
+		struct sockaddr_in *peer = (struct sockaddr_in *)&up.peer_addr;
+
+		peer->sin_family = AF_INET;
+		peer->sin_port = htons(params->port);
+		peer->sin_addr = params->peer;
+
+		ret = params->tcp ? zperf_tcp_upload_async(&up, zperf_cb, NULL)
+				  : zperf_udp_upload_async(&up, zperf_cb, NULL);
+	} else {
+		struct zperf_download_params down = {
+			.port = params->port,
+		};
+
+		ret = params->tcp ? zperf_tcp_download(&down, zperf_cb, NULL)
+				  : zperf_udp_download(&down, zperf_cb, NULL);
+	}
+
+	if (ret < 0) {
+		LOG_ERR("Failed to start zperf %s: %d",
+			params->upload ? "upload" : "server", ret);
+		key = k_spin_lock(&lock);
+		state = ZPERF_IDLE;
+		k_spin_unlock(&lock, key);
+		return ret;
+	}
+
+	LOG_INF("zperf %s %s on port %u", params->tcp ? "TCP" : "UDP",
+		params->upload ? "upload" : "server", params->port);
+
+	return 0;
+}
+
+int zperf_service_stop(void)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	key = k_spin_lock(&lock);
+	if (state != ZPERF_LISTENING) {
+		k_spin_unlock(&lock, key);
+		/* Uploads are bounded by their duration */
+		return state == ZPERF_UPLOADING ? -EBUSY : -EALREADY;
+	}
+	k_spin_unlock(&lock, key);
+
+	ret = active.tcp ? zperf_tcp_download_stop() : zperf_udp_download_stop();
+	if (ret < 0) {
+		LOG_ERR("Failed to stop zperf server: %d", ret);
+		return ret;
+	}
+
+	key = k_spin_lock(&lock);
+	state = ZPERF_IDLE;
+	k_spin_unlock(&lock, key);
+
+	LOG_INF("zperf server stopped");
+	return 0;
+}
+
+int zperf_service_json(char *buf, size_t buf_len)
+{
+	struct zperf_record snapshot[RESULT_COUNT];
+	struct zperf_service_params params;
+	enum zperf_service_state cur;
+	uint32_t count;
+	k_spinlock_key_t key;
+	int64_t now = k_uptime_get();
+	int offset = 0;
+	int remaining = buf_len;
+	int written;
+
+	key = k_spin_lock(&lock);
+	memcpy(snapshot, results, sizeof(snapshot));
+	count = result_count;
+	cur = state;
+	params = active;
+	k_spin_unlock(&lock, key);
+
+	written = snprintf(buf, remaining,
+			   "{\"state\":\"%s\",\"proto\":\"%s\",\"port\":%u,"
+			   "\"sessions\":%u,\"results\":[",
+			   state_names[cur], params.tcp ? "tcp" : "udp",
+			   params.port, count);
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+	offset += written;
+	remaining -= written;
+
+	/* Newest first */
+	for (uint32_t i = 0; i < MIN(count, RESULT_COUNT); i++) {
+		const struct zperf_record *rec =
+			&snapshot[(count - 1 - i) % RESULT_COUNT];
+
+		written = snprintf(
+			buf + offset, remaining,
+			"%s{\"mode\":\"%s\",\"proto\":\"%s\",\"error\":%s,"
+			"\"age_ms\":%lld,\"bytes\":%llu,\"duration_us\":%u,"
+			"\"kbps\":%u,\"packets\":%u,\"lost\":%u,"
+			"\"out_of_order\":%u,\"jitter_us\":%u}",
+			i == 0 ? "" : ",", rec->upload ? "upload" : "download",
+			rec->tcp ? "tcp" : "udp", rec->error ? "true" : "false",
+			(long long)(now - rec->finished),
+			(unsigned long long)rec->bytes, rec->duration_us,
+			rate_kbps(rec->bytes, rec->duration_us), rec->packets,
+			rec->lost, rec->out_of_order, rec->jitter_us);
+		if (written < 0 || written >= remaining) {
+			return -ENOMEM;
+		}
+		offset += written;
+		remaining -= written;
+	}
+
+	written = snprintf(buf + offset, remaining, "]}");
+	if (written < 0 || written >= remaining) {
+		return -ENOMEM;
+	}
+
+	return offset + written;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file zperf_service.h
+ * @brief zperf throughput sessions with retained results
+ */
+
+#ifndef ZPERF_SERVICE_H
+#define ZPERF_SERVICE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/net/net_ip.h>
+
+/** Session parameters */
+struct zperf_service_params {
+	/** TCP instead of UDP */
+	bool tcp;
+	/** Send to @ref peer instead of listening for a client */
+	bool upload;
+	uint16_t port;
+	/** Upload only: receiving station, running "iperf -s" */
+	struct in_addr peer;
+	/** Upload only: session length */
+	uint32_t duration_ms;
+	/** Upload only: UDP send rate, must not be 0 */
+	uint32_t rate_kbps;
+	/** Upload only: payload per packet, must not be 0 */
+	uint16_t packet_size;
+};
+
+/**
+ * @brief Start a receive server or an upload
+ *
+ * A server keeps accepting sessions until zperf_service_stop(); every
+ * finished session is added to the results. An upload ends on its own.
+ *
+ * @param params Session parameters
+ * @return 0 on success, -EINVAL if an upload has no rate or packet size,
+ *         -EBUSY if a server or upload is running, or negative error code
+ */
+int zperf_service_start(const struct zperf_service_params *params);
+
+/**
+ * @brief Stop the running server
+ *
+ * @return 0 on success, -EALREADY if no server is running, or negative
+ *         error code
+ */
+int zperf_service_stop(void);
+
+/**
+ * @brief Get the service state and retained session results as JSON
+ *
+ * @param buf Buffer to store JSON string
+ * @param buf_len Buffer length
+ * @return Number of bytes written, or negative error code
+ */
+int zperf_service_json(char *buf, size_t buf_len);
+
+#endif /* ZPERF_SERVICE_H */
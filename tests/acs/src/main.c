@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "acs.h"
+#include "scan_fixture.h"
+
+static struct acs_ctx ctx;
+static int done_calls;
+static int done_status;
+
+static void scan_done(struct acs_ctx *done_ctx, int status)
+{
+	zassert_equal_ptr(done_ctx, &ctx);
+	done_calls++;
+	done_status = status;
+}
+
+/* Replays the recorded scan synchronously, as a scan source may */
+static int replay_start(struct acs_ctx *scan_ctx, acs_scan_done_cb_t done)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(office_scan); i++) {
+		acs_add_bss(scan_ctx, &office_scan[i]);
+	}
+
+	done(scan_ctx, 0);
+	return 0;
+}
+
+static const struct acs_scan_source replay_source = {
+	.name = "replay",
+	.start = replay_start,
+};
+
+static const struct acs_channel *candidate(uint8_t channel)
+{
+	for (size_t i = 0; i < ctx.num_channels; i++) {
+		if (ctx.channels[i].channel == channel) {
+			return &ctx.channels[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void acs_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	done_calls = 0;
+	done_status = -1;
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_2_4_GHZ, "1,6,11",
+					 true),
+		      3);
+}
+
+ZTEST(acs, test_recorded_scan_selects_quietest)
+{
+	const struct acs_channel *best;
+
+	zassert_ok(replay_source.start(&ctx, scan_done));
+	zassert_equal(done_calls, 1);
+	zassert_equal(done_status, 0);
+	zassert_equal(ctx.bss_total, ARRAY_SIZE(office_scan));
+
+	zassert_equal(candidate(1)->score, OFFICE_SCORE_CH1);
+	zassert_equal(candidate(6)->score, OFFICE_SCORE_CH6);
+	zassert_equal(candidate(11)->score, OFFICE_SCORE_CH11);
+	zassert_equal(candidate(1)->bss_count, 2);
+	zassert_equal(candidate(6)->bss_count, 2);
+	zassert_equal(candidate(11)->bss_count, 1);
+
+	best = acs_select(&ctx);
+	zassert_not_null(best);
+	zassert_equal(best->channel, 11);
+	zassert_equal(best->band, ACS_BAND_2_4_GHZ);
+}
+
+ZTEST(acs, test_adjacent_channels_weighted_by_distance)
+{
+	const struct acs_bss bss = {
+		.band = ACS_BAND_2_4_GHZ,
+		.channel = 3,
+		.rssi = -30,
+	};
+
+	acs_add_bss(&ctx, &bss);
+
+	/* Weight 66 at the RSSI ceiling, 3/5 and 2/5 overlap */
+	zassert_equal(candidate(1)->score, 3 * 66);
+	zassert_equal(candidate(6)->score, 2 * 66);
+	zassert_equal(candidate(11)->score, 0);
+	zassert_equal(candidate(1)->bss_count, 0);
+	zassert_equal(acs_select(&ctx)->channel, 11);
+}
+
+ZTEST(acs, test_rssi_clamped)
+{
+	const struct acs_bss loud = {
+		.band = ACS_BAND_2_4_GHZ,
+		.channel = 1,
+		.rssi = -10,
+	};
+	const struct acs_bss faint = {
+		.band = ACS_BAND_2_4_GHZ,
+		.channel = 6,
+		.rssi = -120,
+	};
+
+	acs_add_bss(&ctx, &loud);
+	acs_add_bss(&ctx, &faint);
+
+	zassert_equal(candidate(1)->score, 5 * 66);
+	zassert_equal(candidate(6)->score, 5 * 1);
+}
+
+ZTEST(acs, test_tie_broken_by_co_channel_count)
+{
+	const struct acs_bss scan[] = {
+		/* 5 * 5 on channel 1, one co-channel BSS */
+		{.band = ACS_BAND_2_4_GHZ, .channel = 1, .rssi = -91},
+		/* 4 * 4 + 3 * 3 on channel 11, none co-channel */
+		{.band = ACS_BAND_2_4_GHZ, .channel = 10, .rssi = -92},
+		{.band = ACS_BAND_2_4_GHZ, .channel = 9, .rssi = -93},
+	};
+
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_2_4_GHZ, "1 11",
+					 true),
+		      2);
+
+	for (size_t i = 0; i < ARRAY_SIZE(scan); i++) {
+		acs_add_bss(&ctx, &scan[i]);
+	}
+
+	zassert_equal(candidate(1)->score, 25);
+	zassert_equal(candidate(11)->score, 25);
+	zassert_equal(acs_select(&ctx)->channel, 11);
+}
+
+ZTEST(acs, test_empty_scan_keeps_candidate_order)
+{
+	zassert_equal(acs_select(&ctx)->channel, 1);
+}
+
+ZTEST(acs, test_5ghz_only_co_channel)
+{
+	const struct acs_bss scan[] = {
+		{.band = ACS_BAND_5_GHZ, .channel = 36, .rssi = -40},
+		{.band = ACS_BAND_5_GHZ, .channel = 40, .rssi = -80},
+		{.band = ACS_BAND_2_4_GHZ, .channel = 1, .rssi = -90},
+	};
+	const struct acs_channel *best;
+
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_5_GHZ, "36,40,44",
+					 false),
+		      3);
+
+	for (size_t i = 0; i < ARRAY_SIZE(scan); i++) {
+		acs_add_bss(&ctx, &scan[i]);
+	}
+
+	/* 40 and 44 are 20 MHz apart and do not overlap */
+	zassert_equal(candidate(36)->score, 5 * 56);
+	zassert_equal(candidate(40)->score, 5 * 16);
+	zassert_equal(candidate(44)->score, 0);
+
+	/* Channel 6 and 11 also score 0 but were added first */
+	best = acs_select(&ctx);
+	zassert_equal(best->channel, 6);
+	zassert_equal(best->band, ACS_BAND_2_4_GHZ);
+}
+
+ZTEST(acs, test_candidate_list_errors)
+{
+	char list[3 * (ACS_MAX_CHANNELS + 1)] = "";
+
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_2_4_GHZ, "0", true),
+		      -EINVAL);
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_2_4_GHZ, "300",
+					 true),
+		      -EINVAL);
+	zassert_equal(acs_add_candidates(NULL, ACS_BAND_2_4_GHZ, "1", true),
+		      -EINVAL);
+
+	for (int i = 0; i <= ACS_MAX_CHANNELS; i++) {
+		strcat(list, "1,");
+	}
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_2_4_GHZ, list, true),
+		      -ENOMEM);
+
+	zassert_equal(acs_add_candidates(&ctx, ACS_BAND_2_4_GHZ, "", true), 0);
+	zassert_is_null(acs_select(&ctx));
+}
+
+ZTEST_SUITE(acs, NULL, NULL, acs_before, NULL, NULL);
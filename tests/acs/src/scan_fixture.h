@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file scan_fixture.h
+ * @brief Recorded 2.4 GHz scan used by the channel selection tests
+ *
+ * Channel and RSSI of every BSS, in the order the wifi scan shell command
+ * lists them: two strong networks on 1, a busy 6, a weak 11 and
+ * non-standard neighbours on 3 and 9 that bleed into the candidates.
+ */
+
+#ifndef SCAN_FIXTURE_H
+#define SCAN_FIXTURE_H
+
+#include "acs.h"
+
+static const struct acs_bss office_scan[] = {
+	{.band = ACS_BAND_2_4_GHZ, .channel = 1, .rssi = -45},
+	{.band = ACS_BAND_2_4_GHZ, .channel = 6, .rssi = -50},
+	{.band = ACS_BAND_2_4_GHZ, .channel = 1, .rssi = -60},
+	{.band = ACS_BAND_2_4_GHZ, .channel = 3, .rssi = -75},
+	{.band = ACS_BAND_2_4_GHZ, .channel = 6, .rssi = -70},
+	{.band = ACS_BAND_2_4_GHZ, .channel = 11, .rssi = -85},
+	{.band = ACS_BAND_2_4_GHZ, .channel = 9, .rssi = -90},
+};
+
+/* Expected scores for candidates 1, 6 and 11: overlap in fifths times
+ * (RSSI + 96), e.g. channel 6 = 5 * 46 + 5 * 26 + 2 * 21 + 2 * 6
+ */
+#define OFFICE_SCORE_CH1  498U
+#define OFFICE_SCORE_CH6  414U
+#define OFFICE_SCORE_CH11 73U
+
+#endif /* SCAN_FIXTURE_H */
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "api_json.h"
+#include "led_api.h"
+#include "led_stub.h"
+#include "microbench_baseline.h"
+
+#define ITERATIONS 1000
+#define STACK_SIZE 4096
+
+/* A case this much slower than its baseline fails */
+#define TOLERANCE_PCT 10
+
+struct bench_case {
+	const char *name;
+	const char *macro;
+	/* One call, returns the bytes produced or consumed */
+	int (*run)(void);
+	uint32_t baseline_cycles;
+	uint32_t baseline_bytes;
+	uint32_t cycles;
+	uint32_t bytes;
+	size_t stack_used;
+	int err;
+};
+
+static char bench_buf[512];
+static char bench_body[48];
+static size_t bench_body_len;
+static char bench_reject_body[48];
+static size_t bench_reject_body_len;
+
+static struct api_json_button buttons[APP_NUM_BUTTONS];
+
+static struct k_thread bench_thread;
+static K_THREAD_STACK_DEFINE(bench_stack, STACK_SIZE);
+
+static int bench_button_json(void)
+{
+	return api_json_buttons(bench_buf, sizeof(bench_buf), buttons,
+				ARRAY_SIZE(buttons));
+}
+
+/* GET /api/leds below admission control, over the stub LED states */
+static int bench_led_json(void)
+{
+	return led_api_states_json(bench_buf, sizeof(bench_buf));
+}
+
+/* The body is tokenized in place, so every call parses a fresh copy */
+static int bench_led_parse(void)
+{
+	struct led_msg msg;
+	int ret;
+
+	memcpy(bench_buf, bench_body, bench_body_len);
+	ret = api_json_led_cmd_parse(bench_buf, bench_body_len, APP_NUM_LEDS,
+				     &msg);
+
+	return (ret < 0) ? ret : (int)bench_body_len;
+}
+
+/* POST /api/led below admission control with a synthetic request, up to
+ * and including the LED_CMD_CHAN publish
+ */
+static int bench_led_post_body(const char *body, size_t len,
+			       enum http_status expected)
+{
+	struct http_request_ctx request = {
+		.data = (uint8_t *)bench_buf,
+		.data_len = len,
+	};
+	struct http_response_ctx response = {0};
+
+	memcpy(bench_buf, body, len);
+	led_api_cmd_process(&request, &response);
+
+	return (response.status == expected) ? (int)len : -EIO;
+}
+
+static int bench_led_post(void)
+{
+	return bench_led_post_body(bench_body, bench_body_len, HTTP_200_OK);
+}
+
+/* Rejected after validation, nothing is published */
+static int bench_led_post_reject(void)
+{
+	return bench_led_post_body(bench_reject_body, bench_reject_body_len,
+				   HTTP_400_BAD_REQUEST);
+}
+
+#define BENCH_CASE(_name, _fn, _case)                                          \
+	{.name = _name,                                                        \
+	 .macro = "MICROBENCH_BASELINE_" #_case,                               \
+	 .run = _fn,                                                           \
+	 .baseline_cycles = MICROBENCH_BASELINE_##_case,                       \
+	 .baseline_bytes = MICROBENCH_BYTES_##_case}
+
+static struct bench_case cases[] = {
+	BENCH_CASE("button_json", bench_button_json, BUTTON_JSON),
+	BENCH_CASE("led_json", bench_led_json, LED_JSON),
+	BENCH_CASE("led_parse", bench_led_parse, LED_PARSE),
+	BENCH_CASE("led_post", bench_led_post, LED_POST),
+	BENCH_CASE("led_post_reject", bench_led_post_reject, LED_POST_REJECT),
+};
+
+static void bench_thread_fn(void *p1, void *p2, void *p3)
+{
+	struct bench_case *bench = p1;
+	uint32_t start;
+	int ret = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < ITERATIONS && ret >= 0; i++) {
+		ret = bench->run();
+	}
+	bench->cycles = (k_cycle_get_32() - start) / ITERATIONS;
+
+	bench->err = MIN(ret, 0);
+	bench->bytes = MAX(ret, 0);
+}
+
+static uint32_t bench_bytes_per_s(const struct bench_case *bench)
+{
+	uint64_t rate;
+
+	if (bench->cycles == 0) {
+		return 0;
+	}
+
+	rate = (uint64_t)bench->bytes * sys_clock_hw_cycles_per_sec() /
+	       bench->cycles;
+
+	return (uint32_t)MIN(rate, UINT32_MAX);
+}
+
+/* Same data as a board with every button pressed a few times and half of
+ * the LEDs on, so the output has its usual length
+ */
+static void *bench_setup(void)
+{
+	const size_t stack_size = K_THREAD_STACK_SIZEOF(bench_stack);
+	size_t unused;
+
+	for (size_t i = 0; i < ARRAY_SIZE(buttons); i++) {
+		buttons[i].number = i;
+		buttons[i].pressed = (i % 2) == 0;
+		buttons[i].count = 100 * (i + 1);
+		buttons[i].bounces = i;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(led_stub_on); i++) {
+		led_stub_on[i] = (i % 2) == 0;
+	}
+
+	/* Sets the last LED to the state it is in, as the app's case does */
+	bench_body_len = snprintf(bench_body, sizeof(bench_body),
+				  "{\"led\":%u,\"action\":\"%s\"}",
+				  APP_NUM_LEDS - 1,
+				  led_stub_on[APP_NUM_LEDS - 1] ? "on" : "off");
+	bench_reject_body_len = snprintf(bench_reject_body,
+					 sizeof(bench_reject_body),
+					 "{\"led\":%u,\"action\":\"off\"}",
+					 APP_NUM_LEDS);
+
+	/* Each case on a fresh thread, so the high-water mark is its own */
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		struct bench_case *bench = &cases[i];
+		k_tid_t tid;
+
+		tid = k_thread_create(&bench_thread, bench_stack, stack_size,
+				      bench_thread_fn, bench, NULL, NULL,
+				      k_thread_priority_get(k_current_get()),
+				      0, K_NO_WAIT);
+		k_thread_join(tid, K_FOREVER);
+
+		bench->stack_used = 0;
+		if (k_thread_stack_space_get(tid, &unused) == 0) {
+			bench->stack_used = stack_size - unused;
+		}
+
+		TC_PRINT("%s: %u cycles, %u bytes, %u bytes/s, "
+			 "%u stack bytes, baseline %u\n",
+			 bench->name, bench->cycles, bench->bytes,
+			 bench_bytes_per_s(bench),
+			 (unsigned int)bench->stack_used,
+			 bench->baseline_cycles);
+	}
+
+	return NULL;
+}
+
+ZTEST(api_json_bench, test_cases_succeed)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		zassert_ok(cases[i].err, "%s failed", cases[i].name);
+		zassert_true(cases[i].bytes > 0, "%s produced nothing",
+			     cases[i].name);
+		zassert_true(cases[i].stack_used < STACK_SIZE,
+			     "%s overflowed its stack", cases[i].name);
+	}
+}
+
+/* Bytes do not depend on the board, any difference is a change in the
+ * serialized output or in the data set
+ */
+ZTEST(api_json_bench, test_bytes)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		zassert_equal(cases[i].bytes, cases[i].baseline_bytes,
+			      "%s: %u bytes, baseline %u", cases[i].name,
+			      cases[i].bytes, cases[i].baseline_bytes);
+	}
+}
+
+#if !defined(CONFIG_ARCH_POSIX)
+/* native_sim does not advance its clock while code runs */
+ZTEST(api_json_bench, test_against_baseline)
+{
+	if (!MICROBENCH_BASELINE_RECORDED) {
+		TC_PRINT("No baseline for %s, add to microbench_baseline.h:\n",
+			 CONFIG_BOARD);
+		for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+			TC_PRINT("#define %s %u\n", cases[i].macro,
+				 cases[i].cycles);
+		}
+		ztest_test_fail();
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		const struct bench_case *bench = &cases[i];
+
+		zassert_true((uint64_t)bench->cycles * 100 <=
+				     (uint64_t)bench->baseline_cycles *
+					     (100 + TOLERANCE_PCT),
+			     "%s: %u cycles, baseline %u", bench->name,
+			     bench->cycles, bench->baseline_cycles);
+	}
+}
+#endif /* !CONFIG_ARCH_POSIX */
+
+ZTEST_SUITE(api_json_bench, NULL, bench_setup, NULL, NULL, NULL);
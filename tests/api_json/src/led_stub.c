@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+
+#include "led_stub.h"
+
+/* led_api.c logs as part of the webserver module */
+LOG_MODULE_REGISTER(webserver_module, CONFIG_WEBSERVER_MODULE_LOG_LEVEL);
+
+bool led_stub_on[APP_NUM_LEDS];
+struct led_msg led_stub_last_cmd;
+atomic_t led_stub_cmds;
+
+int led_get_state(uint8_t led_number, bool *state)
+{
+	if (led_number >= APP_NUM_LEDS) {
+		return -EINVAL;
+	}
+
+	*state = led_stub_on[led_number];
+	return 0;
+}
+
+static void led_cmd_listener(const struct zbus_channel *chan)
+{
+	led_stub_last_cmd = *(const struct led_msg *)zbus_chan_const_msg(chan);
+	atomic_inc(&led_stub_cmds);
+}
+
+ZBUS_LISTENER_DEFINE(led_cmd_listener_def, led_cmd_listener);
+ZBUS_CHAN_DEFINE(LED_CMD_CHAN, struct led_msg, NULL, NULL,
+		 ZBUS_OBSERVERS(led_cmd_listener_def), ZBUS_MSG_INIT(0));
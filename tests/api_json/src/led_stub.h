@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file led_stub.h
+ * @brief LED module stand-in for led_api.c
+ *
+ * led_get_state() reports led_stub_on[] and LED_CMD_CHAN has a listener
+ * that counts the commands and keeps the last one, in place of the LED
+ * state machine.
+ */
+
+#ifndef LED_STUB_H
+#define LED_STUB_H
+
+#include <stdbool.h>
+#include <zephyr/kernel.h>
+
+#include "api_json.h"
+
+extern bool led_stub_on[APP_NUM_LEDS];
+extern struct led_msg led_stub_last_cmd;
+extern atomic_t led_stub_cmds;
+
+#endif /* LED_STUB_H */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "api_json.h"
+#include "led_api.h"
+#include "led_stub.h"
+
+static char buf[256];
+
+static const struct api_json_button two_buttons[] = {
+	{.number = 0, .pressed = false, .count = 3, .bounces = 1},
+	{.number = 1, .pressed = true, .count = 0, .bounces = 0},
+};
+
+static const bool two_leds[] = {true, false};
+
+/* Parses a copy, the parser tokenizes its input */
+static int led_cmd_parse(const char *body, struct led_msg *msg)
+{
+	static char copy[64];
+	size_t len = strlen(body);
+
+	zassert_true(len < sizeof(copy));
+	memcpy(copy, body, len);
+
+	return api_json_led_cmd_parse(copy, len, APP_NUM_LEDS, msg);
+}
+
+/* POST /api/led below admission control, as the resource calls it */
+static enum http_status led_post(const char *body)
+{
+	static char copy[64];
+	size_t len = strlen(body);
+	struct http_request_ctx request = {
+		.data = (uint8_t *)copy,
+		.data_len = len,
+	};
+	struct http_response_ctx response = {0};
+
+	zassert_true(len < sizeof(copy));
+	memcpy(copy, body, len);
+	led_api_cmd_process(&request, &response);
+
+	return response.status;
+}
+
+ZTEST(api_json, test_buttons)
+{
+	/* clang-format off */
+	const char *expected =
+		"{\"buttons\":["
+		"{\"number\":0,\"name\":\"Button 1\",\"pressed\":false, \"count\":3,\"bounces\":1},"
+		"{\"number\":1,\"name\":\"Button 2\",\"pressed\":true, \"count\":0,\"bounces\":0}"
+		"]}";
+	/* clang-format on */
+	int len;
+
+	len = api_json_buttons(buf, sizeof(buf), two_buttons,
+			       ARRAY_SIZE(two_buttons));
+
+	zassert_equal(len, strlen(expected));
+	zassert_str_equal(buf, expected);
+}
+
+ZTEST(api_json, test_leds)
+{
+	const char *expected = "{\"leds\":["
+			       "{\"number\":0,\"name\":\"LED 1\",\"is_on\":true},"
+			       "{\"number\":1,\"name\":\"LED 2\",\"is_on\":false}"
+			       "]}";
+	int len;
+
+	len = api_json_leds(buf, sizeof(buf), two_leds, ARRAY_SIZE(two_leds));
+
+	zassert_equal(len, strlen(expected));
+	zassert_str_equal(buf, expected);
+}
+
+ZTEST(api_json, test_empty_lists)
+{
+	zassert_equal(api_json_buttons(buf, sizeof(buf), NULL, 0),
+		      strlen("{\"buttons\":[]}"));
+	zassert_equal(api_json_leds(buf, sizeof(buf), NULL, 0),
+		      strlen("{\"leds\":[]}"));
+}
+
+ZTEST(api_json, test_buffer_too_small)
+{
+	int len = api_json_leds(buf, sizeof(buf), two_leds,
+				ARRAY_SIZE(two_leds));
+
+	/* Every cut, including the one leaving no room for the terminator */
+	for (int size = 1; size <= len; size++) {
+		zassert_equal(api_json_leds(buf, size, two_leds,
+					    ARRAY_SIZE(two_leds)),
+			      -ENOMEM, "size %d", size);
+	}
+
+	len = api_json_buttons(buf, sizeof(buf), two_buttons,
+			       ARRAY_SIZE(two_buttons));
+	for (int size = 1; size <= len; size++) {
+		zassert_equal(api_json_buttons(buf, size, two_buttons,
+					       ARRAY_SIZE(two_buttons)),
+			      -ENOMEM, "size %d", size);
+	}
+}
+
+ZTEST(api_json, test_led_commands)
+{
+	struct led_msg msg;
+
+	zassert_ok(led_cmd_parse("{\"led\":0,\"action\":\"on\"}", &msg));
+	zassert_equal(msg.led_number, 0);
+	zassert_equal(msg.type, LED_COMMAND_ON);
+
+	zassert_ok(led_cmd_parse("{\"action\":\"off\",\"led\":1}", &msg));
+	zassert_equal(msg.led_number, 1);
+	zassert_equal(msg.type, LED_COMMAND_OFF);
+
+	zassert_ok(led_cmd_parse("{\"led\":3,\"action\":\"toggle\"}", &msg));
+	zassert_equal(msg.led_number, 3);
+	zassert_equal(msg.type, LED_COMMAND_TOGGLE);
+}
+
+ZTEST(api_json, test_led_command_errors)
+{
+	struct led_msg msg;
+
+	zassert_equal(led_cmd_parse("{\"led\":4,\"action\":\"on\"}", &msg),
+		      -ERANGE);
+	zassert_equal(led_cmd_parse("{\"led\":0,\"action\":\"blink\"}", &msg),
+		      -ENOTSUP);
+	zassert_equal(led_cmd_parse("{\"led\":0}", &msg), -ENOTSUP);
+	zassert_true(led_cmd_parse("{\"led\":0,\"action\":", &msg) < 0);
+	zassert_true(led_cmd_parse("led=0&action=on", &msg) < 0);
+	zassert_equal(api_json_led_cmd_parse(buf, 0, APP_NUM_LEDS, &msg),
+		      -EINVAL);
+	zassert_equal(api_json_led_cmd_parse(NULL, 4, APP_NUM_LEDS, &msg),
+		      -EINVAL);
+}
+
+ZTEST(api_json, test_led_states)
+{
+	static char expected[256];
+	int len;
+
+	for (size_t i = 0; i < ARRAY_SIZE(led_stub_on); i++) {
+		led_stub_on[i] = (i == 1);
+	}
+
+	len = api_json_leds(expected, sizeof(expected), led_stub_on,
+			    ARRAY_SIZE(led_stub_on));
+	zassert_true(len > 0);
+
+	zassert_equal(led_api_states_json(buf, sizeof(buf)), len);
+	zassert_str_equal(buf, expected);
+}
+
+ZTEST(api_json, test_led_post)
+{
+	atomic_val_t cmds = atomic_get(&led_stub_cmds);
+
+	zassert_equal(led_post("{\"led\":2,\"action\":\"on\"}"),
+		      HTTP_200_OK);
+	zassert_equal(atomic_get(&led_stub_cmds), cmds + 1);
+	zassert_equal(led_stub_last_cmd.led_number, 2);
+	zassert_equal(led_stub_last_cmd.type, LED_COMMAND_ON);
+}
+
+ZTEST(api_json, test_led_post_rejected)
+{
+	atomic_val_t cmds = atomic_get(&led_stub_cmds);
+
+	zassert_equal(led_post("{\"led\":4,\"action\":\"on\"}"),
+		      HTTP_400_BAD_REQUEST);
+	zassert_equal(led_post("{\"led\":0,\"action\":\"blink\"}"),
+		      HTTP_400_BAD_REQUEST);
+	zassert_equal(led_post("led=0&action=on"), HTTP_400_BAD_REQUEST);
+	zassert_equal(atomic_get(&led_stub_cmds), cmds,
+		      "a rejected command was published");
+}
+
+ZTEST_SUITE(api_json, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "asset_fs.h"
+
+#define ASSET "main.js"
+
+/* gzip -c of 'console.log("asset_fs");' */
+static const uint8_t asset_gz[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x4b, 0xce,
+	0xcf, 0x2b, 0xce, 0xcf, 0x49, 0xd5, 0xcb, 0xc9, 0x4f, 0xd7, 0x50, 0x4a,
+	0x2c, 0x2e, 0x4e, 0x2d, 0x89, 0x4f, 0x2b, 0x56, 0xd2, 0xb4, 0xe6, 0x02,
+	0x00, 0xfe, 0x02, 0x0c, 0x10, 0x19, 0x00, 0x00, 0x00,
+};
+
+static const char plain[] = "console.log(\"not compressed\");\n";
+
+static uint8_t read_buf[CONFIG_APP_ASSET_FS_MAX_SIZE];
+
+/* Read a stored asset back, returns its length */
+static int stored_read(const char *name)
+{
+	struct asset_fs_stream stream;
+	const uint8_t *data;
+	size_t offset = 0;
+	size_t len;
+	int ret;
+
+	ret = asset_fs_open(&stream, name);
+	if (ret < 0) {
+		return ret;
+	}
+
+	do {
+		ret = asset_fs_read(&stream, &data, &len);
+		zassert_true(ret >= 0, "read failed: %d", ret);
+		zassert_true(offset + len <= sizeof(read_buf));
+		memcpy(read_buf + offset, data, len);
+		offset += len;
+	} while (ret == 0);
+
+	asset_fs_close(&stream);
+
+	return offset;
+}
+
+static void upload_stored(void)
+{
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_ok(asset_fs_write(asset_gz, sizeof(asset_gz)));
+	zassert_equal(asset_fs_write_end(true), sizeof(asset_gz));
+}
+
+/* The stored copy is still the one from upload_stored() */
+static void assert_stored_kept(void)
+{
+	zassert_equal(stored_read(ASSET), sizeof(asset_gz));
+	zassert_mem_equal(read_buf, asset_gz, sizeof(asset_gz));
+}
+
+static void asset_fs_before(void *fixture)
+{
+	int ret;
+
+	ARG_UNUSED(fixture);
+
+	ret = asset_fs_remove(ASSET);
+	zassert_true(ret == 0 || ret == -ENOENT, "remove failed: %d", ret);
+}
+
+ZTEST(asset_fs, test_gzip_upload_committed)
+{
+	zassert_equal(stored_read(ASSET), -ENOENT);
+
+	upload_stored();
+
+	assert_stored_kept();
+}
+
+ZTEST(asset_fs, test_uncompressed_upload_rejected)
+{
+	upload_stored();
+
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_equal(asset_fs_write(plain, sizeof(plain) - 1), -EINVAL);
+	zassert_equal(asset_fs_write_end(false), 0);
+
+	assert_stored_kept();
+}
+
+ZTEST(asset_fs, test_magic_split_across_chunks)
+{
+	const uint8_t bad_id2 = 0x8c;
+
+	/* One byte per chunk, as a slow client may send it */
+	zassert_ok(asset_fs_write_begin(ASSET));
+	for (size_t i = 0; i < sizeof(asset_gz); i++) {
+		zassert_ok(asset_fs_write(&asset_gz[i], 1));
+	}
+	zassert_equal(asset_fs_write_end(true), sizeof(asset_gz));
+	assert_stored_kept();
+
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_ok(asset_fs_write(asset_gz, 1));
+	zassert_equal(asset_fs_write(&bad_id2, 1), -EINVAL);
+	zassert_equal(asset_fs_write_end(false), 0);
+	assert_stored_kept();
+}
+
+ZTEST(asset_fs, test_truncated_upload_rejected)
+{
+	upload_stored();
+
+	/* Magic and header, but no deflate data or trailer */
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_ok(asset_fs_write(asset_gz, 10));
+	zassert_equal(asset_fs_write_end(true), -EINVAL);
+	assert_stored_kept();
+
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_equal(asset_fs_write_end(true), -ENODATA);
+	assert_stored_kept();
+}
+
+ZTEST(asset_fs, test_aborted_upload_discarded)
+{
+	upload_stored();
+
+	/* The connection drops after half of the body */
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_ok(asset_fs_write(asset_gz, sizeof(asset_gz) / 2));
+	zassert_equal(asset_fs_write_end(false), 0);
+	assert_stored_kept();
+
+	/* Starting over drops the unfinished upload */
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_ok(asset_fs_write(asset_gz, sizeof(asset_gz) / 2));
+	upload_stored();
+	assert_stored_kept();
+}
+
+ZTEST(asset_fs, test_oversized_upload_rejected)
+{
+	static uint8_t big[CONFIG_APP_ASSET_FS_MAX_SIZE];
+
+	upload_stored();
+
+	memcpy(big, asset_gz, sizeof(asset_gz));
+
+	zassert_ok(asset_fs_write_begin(ASSET));
+	zassert_ok(asset_fs_write(big, sizeof(big)));
+	zassert_equal(asset_fs_write(big, 1), -EFBIG);
+	zassert_equal(asset_fs_write_end(false), 0);
+	assert_stored_kept();
+}
+
+ZTEST(asset_fs, test_content_identity)
+{
+	struct asset_fs_stream stream;
+
+	upload_stored();
+
+	/* From the trailer of asset_gz, whether cached or read from flash */
+	zassert_ok(asset_fs_open(&stream, ASSET));
+	zassert_equal(stream.crc32, 0x100c02fe);
+	zassert_equal(stream.isize, 25);
+	asset_fs_close(&stream);
+
+	assert_stored_kept();
+}
+
+ZTEST_SUITE(asset_fs, NULL, NULL, asset_fs_before, NULL, NULL);
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/settings/settings.h>
+
+static int save_hook(const char *name, const void *value, size_t val_len);
+
+/* Built in so that a simulated reboot can drop the module's RAM state,
+ * with its writes going through save_hook() so they can be failed
+ */
+#define settings_save_one save_hook
+#include "../../../src/modules/state_store/state_store.c"
+#undef settings_save_one
+
+#include <zephyr/stats/stats.h>
+#include <zephyr/ztest.h>
+
+/* Number of module writes still to fail, and attempts seen */
+static int save_failures;
+static int save_attempts;
+
+static int save_hook(const char *name, const void *value, size_t val_len)
+{
+	save_attempts++;
+
+	if (save_failures > 0) {
+		save_failures--;
+		return -EIO;
+	}
+
+	return settings_save_one(name, value, val_len);
+}
+
+ZBUS_CHAN_DEFINE(LED_STATE_CHAN, struct led_state_msg, NULL, NULL,
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+ZBUS_CHAN_DEFINE(BUTTON_CHAN, struct button_msg, NULL, NULL,
+		 ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+/* Long enough for the idle flush to have run */
+#define FLUSH_WAIT K_MSEC(CONFIG_APP_STATE_STORE_IDLE_MS * 2)
+
+/* ============================================================================
+ * FLASH SIMULATOR STATISTICS
+ * ============================================================================
+ */
+
+struct stat_lookup {
+	const char *name;
+	uint32_t *value;
+};
+
+static int stat_find(struct stats_hdr *hdr, void *arg, const char *name,
+		     uint16_t off)
+{
+	struct stat_lookup *lookup = arg;
+
+	if (strcmp(name, lookup->name) == 0) {
+		lookup->value = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t *sim_stat(const char *group, const char *name)
+{
+	struct stat_lookup lookup = {.name = name};
+	struct stats_hdr *hdr = stats_group_find(group);
+
+	zassert_not_null(hdr, "no stats group %s", group);
+	stats_walk(hdr, stat_find, &lookup);
+	zassert_not_null(lookup.value, "no stat %s", name);
+
+	return lookup.value;
+}
+
+static uint32_t *write_calls;
+static uint32_t *max_write_calls;
+static uint32_t *max_len;
+
+/* ============================================================================
+ * HELPERS
+ * ============================================================================
+ */
+
+static void led_publish(uint8_t led_number, bool is_on)
+{
+	struct led_state_msg msg = {
+		.led_number = led_number,
+		.is_on = is_on,
+	};
+
+	zassert_ok(zbus_chan_pub(&LED_STATE_CHAN, &msg, K_NO_WAIT));
+}
+
+static void press_publish(uint8_t button_number, uint32_t press_count)
+{
+	struct button_msg msg = {
+		.type = BUTTON_PRESSED,
+		.button_number = button_number,
+		.press_count = press_count,
+	};
+
+	zassert_ok(zbus_chan_pub(&BUTTON_CHAN, &msg, K_NO_WAIT));
+}
+
+static bool live_led(uint8_t led_number)
+{
+	return (live.led_mask & BIT(led_number)) != 0;
+}
+
+/* Forget everything held in RAM and load from flash, as after a reset */
+static void reboot(void)
+{
+	k_work_cancel_delayable(&flush_work);
+
+	memset(&live, 0, sizeof(live));
+	memset(&persisted, 0, sizeof(persisted));
+	leds_restored = false;
+	presses_restored = false;
+	first_dirty = 0;
+	retry_ms = 0;
+	atomic_clear(&loaded);
+
+	zassert_ok(state_store_load());
+}
+
+static bool led_restored(uint8_t led_number)
+{
+	bool is_on;
+
+	zassert_ok(state_store_led_get(led_number, &is_on));
+	return is_on;
+}
+
+static uint32_t presses_restored_get(uint8_t button_number)
+{
+	uint32_t count;
+
+	zassert_ok(state_store_press_count_get(button_number, &count));
+	return count;
+}
+
+static void *state_store_setup(void)
+{
+	write_calls = sim_stat("flash_sim_stats", "flash_write_calls");
+	max_write_calls = sim_stat("flash_sim_thresholds", "max_write_calls");
+	max_len = sim_stat("flash_sim_thresholds", "max_len");
+
+	zassert_ok(state_store_load());
+
+	return NULL;
+}
+
+static void state_store_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	*max_write_calls = 0;
+	*max_len = 0;
+	save_failures = 0;
+}
+
+/* ============================================================================
+ * TESTS
+ * ============================================================================
+ */
+
+ZTEST(state_store, test_restored_after_reboot)
+{
+	led_publish(0, true);
+	led_publish(1, false);
+	press_publish(0, 12);
+	press_publish(1, 3);
+	k_sleep(FLUSH_WAIT);
+
+	reboot();
+
+	zassert_true(led_restored(0));
+	zassert_false(led_restored(1));
+	zassert_equal(presses_restored_get(0), 12);
+	zassert_equal(presses_restored_get(1), 3);
+}
+
+ZTEST(state_store, test_writes_coalesced_off_the_publish_path)
+{
+	uint32_t before;
+	uint32_t single;
+	uint32_t burst;
+
+	/* Make sure the key exists so both runs rewrite the same record */
+	led_publish(2, !live_led(2));
+	k_sleep(FLUSH_WAIT);
+
+	before = *write_calls;
+	led_publish(2, !live_led(2));
+	zassert_equal(*write_calls, before, "written on the publish path");
+	k_sleep(FLUSH_WAIT);
+	single = *write_calls - before;
+	zassert_true(single > 0);
+
+	before = *write_calls;
+	for (int i = 0; i < 21; i++) {
+		led_publish(2, !live_led(2));
+	}
+	k_sleep(K_MSEC(CONFIG_APP_STATE_STORE_IDLE_MS / 2));
+	zassert_equal(*write_calls, before, "flushed before going idle");
+	k_sleep(FLUSH_WAIT);
+	burst = *write_calls - before;
+
+	zassert_equal(burst, single, "21 changes cost %u writes, one cost %u",
+		      burst, single);
+}
+
+ZTEST(state_store, test_flushed_within_max_delay)
+{
+	const uint32_t before = *write_calls;
+	const int64_t start = k_uptime_get();
+
+	/* Never idle long enough for the idle flush */
+	while (*write_calls == before &&
+	       k_uptime_get() - start <
+		       CONFIG_APP_STATE_STORE_MAX_DELAY_MS * 2) {
+		press_publish(3, (uint32_t)(k_uptime_get() - start));
+		k_sleep(K_MSEC(CONFIG_APP_STATE_STORE_IDLE_MS / 2));
+	}
+
+	zassert_true(*write_calls != before, "no flush under constant change");
+	zassert_true(k_uptime_get() - start <=
+			     CONFIG_APP_STATE_STORE_MAX_DELAY_MS +
+				     CONFIG_APP_STATE_STORE_IDLE_MS,
+		     "flush took %lld ms", k_uptime_get() - start);
+}
+
+ZTEST(state_store, test_failed_write_retried)
+{
+	const int retry = CONFIG_APP_STATE_STORE_RETRY_MS;
+
+	led_publish(1, true);
+	k_sleep(FLUSH_WAIT);
+
+	/* The idle flush and the first retry fail to save the LEDs. The
+	 * retries come IDLE_MS + RETRY_MS and IDLE_MS + 3 * RETRY_MS after
+	 * the change.
+	 */
+	save_failures = 2;
+	save_attempts = 0;
+	led_publish(1, false);
+	k_sleep(FLUSH_WAIT);
+
+	zassert_equal(save_attempts, 1);
+	zassert_not_equal(first_dirty, 0, "failed flush marked clean");
+
+	/* A change while waiting does not cut the backoff short */
+	press_publish(1, 8);
+	k_sleep(K_MSEC(retry / 4));
+	zassert_equal(save_attempts, 1, "retried before the backoff");
+
+	/* The LEDs fail again, the counters are saved */
+	k_sleep(K_MSEC(retry / 2));
+	zassert_equal(save_attempts, 3);
+
+	k_sleep(K_MSEC(retry));
+	zassert_equal(save_attempts, 3, "backoff did not double");
+
+	k_sleep(K_MSEC(retry));
+	zassert_equal(save_attempts, 4);
+	zassert_equal(retry_ms, 0, "backoff not reset after success");
+
+	reboot();
+	zassert_false(led_restored(1));
+	zassert_equal(presses_restored_get(1), 8);
+}
+
+ZTEST(state_store, test_power_cut_during_write)
+{
+	led_publish(3, true);
+	press_publish(2, 40);
+	k_sleep(FLUSH_WAIT);
+
+	/* Let the next write land only partially and drop everything after
+	 * it, as if power failed while the record was being written
+	 */
+	*max_write_calls = *write_calls + 1;
+	*max_len = 1;
+
+	led_publish(3, false);
+	press_publish(2, 41);
+	k_sleep(FLUSH_WAIT);
+
+	*max_write_calls = 0;
+	*max_len = 0;
+
+	reboot();
+
+	/* Each key holds its last complete value */
+	zassert_true(led_restored(3));
+	zassert_equal(presses_restored_get(2), 40);
+
+	/* And the store keeps working once power is back */
+	led_publish(3, false);
+	k_sleep(FLUSH_WAIT);
+	reboot();
+	zassert_false(led_restored(3));
+}
+
+ZTEST(state_store, test_corrupted_records_ignored)
+{
+	const uint16_t short_mask = 0x5;
+	const uint8_t torn_presses[6] = {1, 0, 0, 0, 2, 0};
+
+	zassert_ok(settings_save_one("app/leds", &short_mask,
+				     sizeof(short_mask)));
+	zassert_ok(settings_save_one("app/presses", torn_presses,
+				     sizeof(torn_presses)));
+
+	reboot();
+
+	zassert_equal(state_store_led_get(0, &(bool){false}), -ENOENT);
+	zassert_equal(state_store_press_count_get(0, &(uint32_t){0}),
+		      -ENOENT);
+
+	/* Defaults are used and the next change replaces the records */
+	led_publish(0, true);
+	press_publish(0, 5);
+	k_sleep(FLUSH_WAIT);
+	reboot();
+
+	zassert_true(led_restored(0));
+	zassert_equal(presses_restored_get(0), 5);
+}
+
+ZTEST(state_store, test_presses_from_other_button_count)
+{
+	const uint32_t fewer[2] = {7, 9};
+	uint32_t more[APP_NUM_BUTTONS + 2];
+
+	/* Written by a build for a board with two buttons */
+	zassert_ok(settings_save_one("app/presses", fewer, sizeof(fewer)));
+	reboot();
+
+	zassert_equal(presses_restored_get(0), 7);
+	zassert_equal(presses_restored_get(1), 9);
+	for (uint8_t i = ARRAY_SIZE(fewer); i < APP_NUM_BUTTONS; i++) {
+		zassert_equal(presses_restored_get(i), 0);
+	}
+
+	/* Written by a build for a board with more buttons */
+	for (size_t i = 0; i < ARRAY_SIZE(more); i++) {
+		more[i] = 100 + i;
+	}
+	zassert_ok(settings_save_one("app/presses", more, sizeof(more)));
+	reboot();
+
+	for (uint8_t i = 0; i < APP_NUM_BUTTONS; i++) {
+		zassert_equal(presses_restored_get(i), 100 + i);
+	}
+}
+
+ZTEST_SUITE(state_store, NULL, state_store_setup, NULL, state_store_after,
+	    NULL);
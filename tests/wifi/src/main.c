@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/net/dhcpv4_server.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/net/wifi_mgmt.h>
+
+static struct net_if *test_iface(void);
+static int test_net_mgmt(uint64_t request, struct net_if *iface, void *data,
+			 size_t len);
+static int test_dhcp_start(struct net_if *iface, struct in_addr *base);
+static int test_dhcp_stop(struct net_if *iface);
+static int test_inet_pton(int family, const char *src, void *dst);
+
+/* Built in so the state machine can be reset and inspected, with every
+ * call into the network stack answered by the test. There is no radio,
+ * the SoftAP itself is driven through wifi_set_ap_ops().
+ */
+#undef net_mgmt
+#undef inet_pton
+#define net_mgmt(_req, _iface, _data, _len)                                    \
+	test_net_mgmt(_req, _iface, _data, _len)
+#define net_if_get_first_wifi()          test_iface()
+#define net_dhcpv4_server_start(_i, _b)  test_dhcp_start(_i, _b)
+#define net_dhcpv4_server_stop(_i)       test_dhcp_stop(_i)
+#define inet_pton(_af, _src, _dst)       test_inet_pton(_af, _src, _dst)
+#include "../../../src/modules/wifi/wifi.c"
+#undef net_mgmt
+#undef net_if_get_first_wifi
+#undef net_dhcpv4_server_start
+#undef net_dhcpv4_server_stop
+#undef inet_pton
+
+#include <zephyr/ztest.h>
+
+#define BACKOFF_MIN CONFIG_WIFI_RECOVERY_BACKOFF_MIN_MS
+#define BACKOFF_MAX CONFIG_WIFI_RECOVERY_BACKOFF_MAX_MS
+
+/* Margin around every timer the test waits on */
+#define SLACK_MS 30
+
+/* ============================================================================
+ * NETWORK STACK STAND-INS
+ * ============================================================================
+ */
+
+static struct net_if test_net_if;
+
+static struct net_if *test_iface(void)
+{
+	return &test_net_if;
+}
+
+static int test_net_mgmt(uint64_t request, struct net_if *iface, void *data,
+			 size_t len)
+{
+	ARG_UNUSED(request);
+	ARG_UNUSED(iface);
+	ARG_UNUSED(data);
+	ARG_UNUSED(len);
+
+	return 0;
+}
+
+static int test_dhcp_start(struct net_if *iface, struct in_addr *base)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(base);
+
+	return 0;
+}
+
+static int test_dhcp_stop(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	return 0;
+}
+
+static int test_inet_pton(int family, const char *src, void *dst)
+{
+	ARG_UNUSED(family);
+	ARG_UNUSED(src);
+
+	memset(dst, 0, sizeof(struct in_addr));
+	return 1;
+}
+
+int network_wait_for_iface_up(k_timeout_t timeout)
+{
+	ARG_UNUSED(timeout);
+
+	return 0;
+}
+
+int network_wait_for_supplicant_ready(k_timeout_t timeout)
+{
+	ARG_UNUSED(timeout);
+
+	return 0;
+}
+
+/* ============================================================================
+ * SOFTAP AND SCAN STUBS
+ * ============================================================================
+ */
+
+/* Returned by enable(), the asynchronous result is sent by the test */
+static int enable_ret;
+static int enable_calls;
+static int disable_calls;
+static enum wifi_frequency_bands enable_band;
+static uint8_t enable_channel;
+
+static int stub_enable(struct net_if *iface,
+		       struct wifi_connect_req_params *params)
+{
+	ARG_UNUSED(iface);
+
+	enable_calls++;
+	enable_band = params->band;
+	enable_channel = params->channel;
+
+	return enable_ret;
+}
+
+static int stub_disable(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	disable_calls++;
+	return 0;
+}
+
+static const struct wifi_ap_ops stub_ops = {
+	.name = "stub",
+	.enable = stub_enable,
+	.disable = stub_disable,
+};
+
+/* Completes at once with these results */
+static int scan_status;
+static const struct acs_bss *scan_bss;
+static size_t scan_bss_count;
+
+static int stub_scan_start(struct acs_ctx *ctx, acs_scan_done_cb_t done)
+{
+	for (size_t i = 0; i < scan_bss_count; i++) {
+		acs_add_bss(ctx, &scan_bss[i]);
+	}
+
+	done(ctx, scan_status);
+	return 0;
+}
+
+static const struct acs_scan_source stub_scan = {
+	.name = "stub",
+	.start = stub_scan_start,
+};
+
+/* Last message on WIFI_CHAN */
+static struct wifi_msg wifi_last_msg;
+
+static void wifi_test_listener(const struct zbus_channel *chan)
+{
+	wifi_last_msg = *(const struct wifi_msg *)zbus_chan_const_msg(chan);
+}
+
+ZBUS_LISTENER_DEFINE(wifi_test_listener_def, wifi_test_listener);
+ZBUS_CHAN_ADD_OBS(WIFI_CHAN, wifi_test_listener_def, 0);
+
+/* ============================================================================
+ * HELPERS
+ * ============================================================================
+ */
+
+static void start_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	wifi_start_softap();
+}
+
+static K_WORK_DEFINE(start_work, start_fn);
+
+/* Start from the event loop, as wifi_module_start() does */
+static void start(void)
+{
+	event_loop_submit(&start_work);
+	k_sleep(K_MSEC(SLACK_MS));
+}
+
+/* NET_EVENT_WIFI_AP_ENABLE_RESULT as the driver would report it */
+static void ap_enable_result(int status)
+{
+	struct wifi_status result = {.status = status};
+	struct net_mgmt_event_callback cb = {
+		.info = &result,
+		.info_length = sizeof(result),
+	};
+
+	wifi_mgmt_event_handler(&cb, NET_EVENT_WIFI_AP_ENABLE_RESULT,
+				&test_net_if);
+	k_sleep(K_MSEC(SLACK_MS));
+}
+
+static bool in_state(enum wifi_state state)
+{
+	return SMF_CTX(&wifi_sm)->current == &wifi_states[state];
+}
+
+static struct wifi_recovery_stats stats_get(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&recovery_lock);
+	struct wifi_recovery_stats stats = recovery_stats;
+
+	k_spin_unlock(&recovery_lock, key);
+
+	return stats;
+}
+
+/* The SoftAP fails with error, the next attempt follows after backoff */
+static void expect_failure(int error, uint32_t failures, uint32_t backoff)
+{
+	struct wifi_recovery_stats stats = stats_get();
+
+	zassert_true(in_state(WIFI_STATE_ERROR), "not in the error state");
+	zassert_equal(wifi_sm.consecutive_failures, failures);
+	zassert_equal(stats.last_error, error);
+	zassert_equal(stats.backoff_ms, backoff, "backoff %u, expected %u",
+		      stats.backoff_ms, backoff);
+	zassert_equal(wifi_last_msg.type, WIFI_ERROR);
+	zassert_equal(wifi_last_msg.error_code, error);
+}
+
+/* ============================================================================
+ * TESTS
+ * ============================================================================
+ */
+
+ZTEST(wifi, test_sync_error)
+{
+	enable_ret = -EIO;
+	start();
+
+	zassert_equal(enable_calls, 1);
+	expect_failure(-EIO, 1, BACKOFF_MIN);
+	zassert_equal(disable_calls, 1, "SoftAP not torn down");
+	zassert_equal(stats_get().failures, 1);
+}
+
+ZTEST(wifi, test_async_failure)
+{
+	start();
+	zassert_true(in_state(WIFI_STATE_STARTING));
+	zassert_equal(disable_calls, 0);
+
+	ap_enable_result(-EIO);
+
+	expect_failure(-EIO, 1, BACKOFF_MIN);
+	zassert_equal(disable_calls, 1, "SoftAP not torn down");
+}
+
+ZTEST(wifi, test_enable_timeout)
+{
+	start();
+
+	k_sleep(K_MSEC(CONFIG_WIFI_RECOVERY_ENABLE_TIMEOUT_MS - 2 * SLACK_MS));
+	zassert_true(in_state(WIFI_STATE_STARTING), "timed out early");
+
+	k_sleep(K_MSEC(3 * SLACK_MS));
+	expect_failure(-ETIMEDOUT, 1, BACKOFF_MIN);
+
+	/* A result after the timeout does not bring the SoftAP up */
+	ap_enable_result(0);
+	zassert_true(in_state(WIFI_STATE_ERROR));
+}
+
+ZTEST(wifi, test_backoff_doubles_up_to_cap)
+{
+	uint32_t backoff = BACKOFF_MIN;
+
+	enable_ret = -EIO;
+	start();
+
+	/* MIN, 2*MIN, ... up to MAX, and MAX twice more once reached */
+	for (uint32_t failures = 1, at_cap = 0; at_cap < 3; failures++) {
+		expect_failure(-EIO, failures, backoff);
+		zassert_equal(enable_calls, failures);
+
+		/* The failure was SLACK_MS ago */
+		k_sleep(K_MSEC(backoff - 2 * SLACK_MS));
+		zassert_equal(enable_calls, failures, "retried before %u ms",
+			      backoff);
+
+		k_sleep(K_MSEC(2 * SLACK_MS));
+		zassert_equal(enable_calls, failures + 1,
+			      "no retry after %u ms", backoff);
+
+		at_cap += (backoff == BACKOFF_MAX);
+		backoff = MIN(backoff * 2, BACKOFF_MAX);
+	}
+
+	zassert_equal(stats_get().retries, enable_calls - 1);
+}
+
+ZTEST(wifi, test_recovery)
+{
+	enable_ret = -EIO;
+	start();
+	expect_failure(-EIO, 1, BACKOFF_MIN);
+
+	k_sleep(K_MSEC(BACKOFF_MIN + SLACK_MS));
+	expect_failure(-EIO, 2, 2 * BACKOFF_MIN);
+
+	enable_ret = 0;
+	k_sleep(K_MSEC(2 * BACKOFF_MIN + SLACK_MS));
+	zassert_equal(enable_calls, 3);
+	zassert_true(in_state(WIFI_STATE_STARTING));
+
+	ap_enable_result(0);
+
+	struct wifi_recovery_stats stats = stats_get();
+
+	zassert_true(in_state(WIFI_STATE_ACTIVE), "SoftAP not active");
+	zassert_equal(wifi_sm.consecutive_failures, 0);
+	zassert_equal(stats.failures, 2);
+	zassert_equal(stats.retries, 2);
+	zassert_equal(stats.recoveries, 1);
+	zassert_equal(stats.backoff_ms, 0);
+	zassert_equal(stats.outage_start, 0);
+	zassert_true(stats.last_recovery_ms >= 3 * BACKOFF_MIN);
+	zassert_equal(wifi_last_msg.type, WIFI_SOFTAP_STARTED);
+}
+
+ZTEST(wifi, test_acs_fallback_channel)
+{
+	/* Strong neighbours on 1 and 6, so the scan picks 11 */
+	static const struct acs_bss busy[] = {
+		{.band = ACS_BAND_2_4_GHZ, .channel = 1, .rssi = -40},
+		{.band = ACS_BAND_2_4_GHZ, .channel = 6, .rssi = -40},
+	};
+
+	scan_bss = busy;
+	scan_bss_count = ARRAY_SIZE(busy);
+	enable_ret = -EIO;
+	start();
+	zassert_equal(enable_channel, 11);
+
+	/* The retry rescans, fails, and uses the configured channel */
+	scan_status = -EIO;
+	k_sleep(K_MSEC(BACKOFF_MIN + SLACK_MS));
+	zassert_equal(enable_calls, 2);
+	zassert_equal(enable_band, WIFI_FREQ_BAND_2_4_GHZ);
+	zassert_equal(enable_channel, CONFIG_WIFI_AP_CHANNEL);
+}
+
+/* ============================================================================
+ * FIXTURE
+ * ============================================================================
+ */
+
+static void wifi_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	enable_ret = 0;
+	enable_calls = 0;
+	disable_calls = 0;
+	enable_channel = 0;
+	scan_status = 0;
+	scan_bss = NULL;
+	scan_bss_count = 0;
+	memset(&wifi_last_msg, 0, sizeof(wifi_last_msg));
+
+	wifi_set_ap_ops(&stub_ops);
+	wifi_acs_set_scan_source(&stub_scan);
+}
+
+/* Back to IDLE with no timer pending, as after boot */
+static void wifi_after(void *fixture)
+{
+	struct k_work_sync sync;
+
+	ARG_UNUSED(fixture);
+
+	k_work_cancel_delayable_sync(&wifi_retry_work, &sync);
+	k_work_cancel_delayable_sync(&wifi_start_timeout_work, &sync);
+	k_work_cancel_delayable_sync(&acs_timeout_work, &sync);
+	k_work_flush(&wifi_run_work, &sync);
+
+	wifi_sm.consecutive_failures = 0;
+	wifi_sm.band = WIFI_FREQ_BAND_2_4_GHZ;
+	wifi_sm.channel = CONFIG_WIFI_AP_CHANNEL;
+	recovery_stats = (struct wifi_recovery_stats){0};
+	smf_set_initial(SMF_CTX(&wifi_sm), &wifi_states[WIFI_STATE_IDLE]);
+}
+
+ZTEST_SUITE(wifi, NULL, NULL, wifi_before, wifi_after, NULL);
@@ -4,13 +4,19 @@
 
 // Configuration
 const API_BASE = '';
-const REFRESH_INTERVAL = 500; // ms
+const REFRESH_INTERVAL = 500; // ms, until the server sends a hint
+const MIN_POLL_INTERVAL = 250; // ms
+const MAX_POLL_INTERVAL = 30000; // ms
+const MAX_ERROR_BACKOFF = 15000; // ms
 
 const BUTTON_PRESSED_COLOR = '#4caf50';
 const BUTTON_RELEASED_COLOR = '#757575';
 
 // State
-let updateInterval = null;
+let pollTimer = null;
+let pollInterval = REFRESH_INTERVAL;
+let pollErrors = 0;
+let pollInFlight = false;
 let buttonGrid = null;
 let buttonTemplate = null;
 let buttonPlaceholder = null;
@@ -34,33 +40,86 @@ document.addEventListener('DOMContentLoaded', function() {
     ledPlaceholder = document.getElementById('led-placeholder');
 
     startAutoUpdate();
-    updateButtonStates();
-    updateLEDStates();
-    
+
     // Set WiFi SSID (from CONFIG_APP_WIFI_SSID, hardcoded for now)
     document.getElementById('wifi-ssid').textContent = 'nRF70-WebServer';
 });
 
 // Start automatic updates
 function startAutoUpdate() {
-    if (updateInterval) {
-        clearInterval(updateInterval);
-    }
-    
-    updateInterval = setInterval(function() {
-        updateButtonStates();
-        updateLEDStates();
-    }, REFRESH_INTERVAL);
-    
+    schedulePoll(0);
     console.log('Auto-update started');
 }
 
+function stopAutoUpdate() {
+    if (pollTimer) {
+        clearTimeout(pollTimer);
+        pollTimer = null;
+    }
+}
+
+function schedulePoll(delay) {
+    stopAutoUpdate();
+    pollTimer = setTimeout(pollOnce, delay);
+}
+
+// One poll cycle; the next one is scheduled only after both requests finish
+async function pollOnce() {
+    pollTimer = null;
+    if (document.hidden || pollInFlight) {
+        return;
+    }
+
+    pollInFlight = true;
+    const results = await Promise.all([updateButtonStates(), updateLEDStates()]);
+    pollInFlight = false;
+
+    pollErrors = results.every(result => result.ok) ? 0 : pollErrors + 1;
+
+    const hint = Math.max(...results.map(result => result.hint));
+    if (hint > 0) {
+        pollInterval = Math.min(Math.max(hint, MIN_POLL_INTERVAL), MAX_POLL_INTERVAL);
+    }
+
+    if (!document.hidden) {
+        const retryAfter = Math.max(...results.map(result => result.retryAfter));
+        schedulePoll(Math.max(nextPollDelay(), retryAfter));
+    }
+}
+
+// Jitter keeps stations from polling in lockstep
+function nextPollDelay() {
+    if (pollErrors === 0) {
+        return pollInterval * (0.9 + Math.random() * 0.2);
+    }
+
+    const backoff = Math.min(MAX_ERROR_BACKOFF, pollInterval * 2 ** pollErrors);
+    return backoff / 2 + Math.random() * backoff / 2;
+}
+
+// Poll interval hint and Retry-After from a response, in ms (0 if absent)
+function pollResult(response) {
+    const hint = Number(response.headers.get('X-Poll-Interval'));
+    const retryAfter = Number(response.headers.get('Retry-After'));
+
+    return {
+        ok: response.ok,
+        hint: Number.isFinite(hint) && hint > 0 ? hint : 0,
+        retryAfter: Number.isFinite(retryAfter) && retryAfter > 0 ? retryAfter * 1000 : 0,
+    };
+}
+
+const POLL_FAILED = { ok: false, hint: 0, retryAfter: 0 };
+
 // Update button states from API
 async function updateButtonStates() {
     try {
         const response = await fetch(`${API_BASE}/api/buttons`);
+        const result = pollResult(response);
         if (!response.ok) {
-            throw new Error(`HTTP error ${response.status}`);
+            const error = new Error(`HTTP error ${response.status}`);
+            error.result = result;
+            throw error;
         }
         
         const data = await response.json();
@@ -71,6 +130,7 @@ async function updateButtonStates() {
         
         // Update connection status
         updateConnectionStatus(true);
+        return result;
         
     } catch (error) {
         console.error('Failed to update button states:', error);
@@ -79,6 +139,7 @@ async function updateButtonStates() {
             buttonPlaceholder.style.display = 'block';
         }
         updateConnectionStatus(false);
+        return error.result || POLL_FAILED;
     }
 }
 
@@ -86,12 +147,16 @@ async function updateButtonStates() {
 async function updateLEDStates() {
     try {
         const response = await fetch(`${API_BASE}/api/leds`);
+        const result = pollResult(response);
         if (!response.ok) {
-            throw new Error(`HTTP error ${response.status}`);
+            const error = new Error(`HTTP error ${response.status}`);
+            error.result = result;
+            throw error;
         }
         
         const data = await response.json();
         renderLedStates(data);
+        return result;
         
     } catch (error) {
         console.error('Failed to update LED states:', error);
@@ -99,6 +164,7 @@ async function updateLEDStates() {
             ledPlaceholder.textContent = 'Failed to load LED data';
             ledPlaceholder.style.display = 'block';
         }
+        return error.result || POLL_FAILED;
     }
 }
 
@@ -150,11 +216,18 @@ function updateConnectionStatus(isConnected) {
     }
 }
 
+// Stop polling while the tab is hidden, refresh at once when it returns
+document.addEventListener('visibilitychange', function() {
+    if (document.hidden) {
+        stopAutoUpdate();
+    } else {
+        schedulePoll(0);
+    }
+});
+
 // Cleanup on page unload
 window.addEventListener('beforeunload', function() {
-    if (updateInterval) {
-        clearInterval(updateInterval);
-    }
+    stopAutoUpdate();
 });
 
 // Helpers